@@ -29,8 +29,8 @@ enum {
 
 
 enum {
-    RECV_BUFFER_LENGTH= 8, ///< The receive buffer length
-    TRAN_BUFFER_LENGTH= 50 ///< The transmit buffer length
+    RECV_BUFFER_LENGTH= 8, ///< The receive buffer length (a power of two)
+    TRAN_BUFFER_LENGTH= 64 ///< The transmit buffer length (a power of two)
 };
 
 
@@ -38,15 +38,20 @@ enum {
 //@{
 static Queue _recvQueue;
 static Queue _tranQueue;
+#if defined( Q_STATS )
+static bool _waitForRoom;   ///< whether putchar() waits for room to send
+#endif
 //@}
 
 
 /** Low level output interface of Keil C51's Standard I/O. */
 char putchar ( char ch )
 {
-    if (!Q_full(&_tranQueue))
-		Q_put(&_tranQueue, ch);
-    else
+#if defined( Q_STATS )
+    while (_waitForRoom && Q_full(&_tranQueue))
+        CON_Update();
+#endif
+    if (!Q_tryPut(&_tranQueue, ch))
         gErrorCode = EC_USART_WRITE_CHAR;
     return ch;
 }
@@ -130,13 +135,29 @@ void CON_Update()
     // Is data ready to be read into the received buffer?
     if (RI == 1) {
         // Read the data from USART buffer
-        if (!Q_full(&_recvQueue))
-        	Q_put(&_recvQueue, SBUF);
+        Q_tryPut(&_recvQueue, SBUF);
         RI = 0;  // Clear RT flag
     }
 }
 
 
+#if defined( Q_STATS )
+
+/** Prints the statistics of the console queues, e.g. from a menu command.
+ * The dump is longer than the transmit buffer, so putchar() waits for
+ * room meanwhile instead of dropping characters.
+ */
+void CON_DumpStats()
+{
+    _waitForRoom= true;
+    Q_dumpStats(&_recvQueue, "recv");
+    Q_dumpStats(&_tranQueue, "tran");
+    _waitForRoom= false;
+}
+
+#endif // Q_STATS
+
+
 /** Sends a character via UART.
  *  - This is based on Keil sample code, with added (loop) timeouts.
  *  - Implements Xon / Off control.
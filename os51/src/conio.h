@@ -24,6 +24,10 @@ void CON_Init( uint16_t );
 /// Must schedule or otherwise regularly call this function...
 void CON_Update();
 
+#if defined( Q_STATS )
+    void CON_DumpStats();
+#endif
+
 int kbhit();
 int ungetch( int ch );
 int getch();
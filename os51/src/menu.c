@@ -63,7 +63,11 @@ static void MENU_ShowMenu()
     printf("Menu:\n");
     printf("a - x\n");
     printf("b - x\n");
-    printf("c - x\n\n");
+    printf("c - x\n");
+#if defined( Q_STATS )
+    printf("q - queue statistics\n");
+#endif
+    printf("\n");
     printf("? : ");
 }
 
@@ -93,6 +97,12 @@ static void MENU_PerformTask( char ch )
             FunctionC();
             break;
 
+#if defined( Q_STATS )
+        case 'Q':
+            CON_DumpStats();
+            break;
+#endif
+
         default:
             ; // dummy
     }
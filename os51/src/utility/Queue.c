@@ -3,11 +3,196 @@
  *      Implementes a queue module, and that uses a circular array.
  * @author Jiang Yu-Kuan yukuan.jiang@gmail.com
  * @date 2006/05/07 (initial version)
- * @date 2006/05/18 (last revision)
- * @version 2.0
+ * @date 2026/10/17 (last revision)
+ * @version 2.1
  */
 #include "Queue.h"
 #include <assert.h>
+#if defined( Q_STATS )
+    #include <stdio.h>
+    #include <string.h>
+#endif
+
+
+#if defined( Q_STATS )
+
+/** Accounts an item just put, and starts a latency sample if due.
+ * The sample is the first item put at or after every
+ * #Q_LATENCY_SAMPLE_PERIOD puts; only one item is sampled at a time.
+ */
+static void statPut( Queue* q )
+{
+    QueueStats* s= &q->stats;
+
+    if (!s->sampling && ((Idx8)s->puts & (Q_LATENCY_SAMPLE_PERIOD-1)) == 0) {
+        s->sampling= true;
+        s->sampleAhead= Q_size(q) - 1;
+        s->sampleTick= Q_STATS_CLOCK();
+    }
+    ++s->puts;
+    if (Q_size(q) > s->highWater)
+        s->highWater= Q_size(q);
+}
+
+
+/** Accounts an item just gotten, and ends the latency sample if it is
+ *  the one.
+ */
+static void statGet( Queue* q )
+{
+    QueueStats* s= &q->stats;
+
+    if (s->sampling) {
+        if (s->sampleAhead == 0) {
+            QStatTick ticks= Q_STATS_CLOCK() - s->sampleTick;
+            Idx8 k= 0;
+
+            while (ticks != 0 && k < Q_LATENCY_BUCKETS-1) {
+                ++k;
+                ticks >>= 1;
+            }
+            ++s->latency[k];
+            s->sampling= false;
+        }
+        else
+            --s->sampleAhead;
+    }
+    ++s->gets;
+}
+
+
+/** Accounts a get rolled back by Q_unget(). */
+static void statUnget( Queue* q )
+{
+    --q->stats.gets;
+    if (q->stats.sampling)
+        ++q->stats.sampleAhead;
+}
+
+#endif // Q_STATS
+
+
+#if Q_POW2_IDX8
+
+/*
+ * The indices run freely in 8 bits and are masked on every access, so
+ * "end - first" is the size of a queue and no 16-bit division is called.
+ * The buffer size is limited to 128 to tell a full queue from an empty one.
+ */
+
+/** Initilizes a queue.
+ * @param[in,out] q the queue to be initialized.
+ * @param[in] buf the buffer to store items.
+ * @param[in] buf_size the buffer size; a power of two, at most 128.
+ */
+void Q_init( Queue* q, QueueItem* buf, size_t buf_size )
+{
+    //assert (buf_size <= 128 && (buf_size & (buf_size-1)) == 0);
+
+    q->first= 0;
+    q->end= 0;
+    q->mask= (Idx8)(buf_size - 1);
+    q->buf= buf;
+    Q_resetStats(q);
+}
+
+
+/** Clear the queue */
+void Q_clear( Queue* q )
+{
+    q->first= 0;
+    q->end= 0;
+    Q_STAT( q->stats.sampling= false; )
+}
+
+
+/** Puts an item to the end of a queue.
+ * @param[in,out] q the queue to add an item.
+ * @param[in] i the added item.
+ */
+void Q_put( Queue* q, QueueItem i )
+{
+    //assert (!Q_full(q));
+
+    q->buf[q->end & q->mask]= i;
+    ++q->end;
+    Q_STAT( statPut(q); )
+}
+
+
+/** Gets the first item of a queue.
+ * @param[in,out] q the queue to get an item.
+ * @return the gotton item
+ */
+QueueItem Q_get( Queue* q )
+{
+    QueueItem i;
+    //assert (!Q_empty(q));
+
+    i= q->buf[q->first & q->mask];
+    ++q->first;
+    Q_STAT( statGet(q); )
+    return i;
+}
+
+
+/** Rolls back a "get" operation.
+ * This cannot work correctly next to 'clear' operation.
+ * @return the previous character
+ */
+QueueItem Q_unget( Queue* q )
+{
+    Q_STAT( statUnget(q); )
+    --q->first;
+    return q->buf[q->first & q->mask];
+}
+
+
+/** Peeks the first item of a queue.
+ * @param[in] q the queue to get an item.
+ * @return the peeked item
+ */
+QueueItem Q_first( const Queue* q )
+{
+    //assert (!Q_empty(q));
+
+    return q->buf[q->first & q->mask];
+}
+
+
+/** Peeks the last item of a queue.
+ * @param[in] q the queue to get an item.
+ * @return the peeked item
+ */
+QueueItem Q_last( const Queue* q )
+{
+    //assert (!Q_empty(q));
+
+    return q->buf[(Idx8)(q->end - 1) & q->mask];
+}
+
+
+/** Gets the size of a queue at the moment. */
+size_t Q_size( const Queue* q )
+{
+    return (Idx8)(q->end - q->first);
+}
+
+
+/** Determines if a queue is empty. */
+bool Q_empty( const Queue* q )
+{
+    return q->end == q->first;
+}
+
+
+/** Determines if an queue is full */
+bool Q_full( const Queue* q )
+{
+    return (Idx8)(q->end - q->first) > q->mask;
+}
+
+#else
 
 
 /** Initilizes a queue.
@@ -22,6 +207,7 @@ void Q_init( Queue* q, QueueItem* buf, size_t buf_size )
     q->count= 0;
     q->buf= buf;
     q->buf_size= buf_size;
+    Q_resetStats(q);
 }
 
 
@@ -31,6 +217,7 @@ void Q_clear( Queue* q )
     q->first= 0;
     q->end= 0;
     q->count= 0;
+    Q_STAT( q->stats.sampling= false; )
 }
 
 
@@ -45,6 +232,7 @@ void Q_put( Queue* q, QueueItem i )
     ++q->count;
     q->buf[q->end]= i;
     q->end= (q->end+1) % q->buf_size;
+    Q_STAT( statPut(q); )
 }
 
 
@@ -60,6 +248,7 @@ QueueItem Q_get( Queue* q )
     --q->count;
     i= q->buf[q->first];
     q->first= (q->first+1) % q->buf_size;
+    Q_STAT( statGet(q); )
     return i;
 }
 
@@ -70,6 +259,7 @@ QueueItem Q_get( Queue* q )
  */
 QueueItem Q_unget( Queue* q )
 {
+    Q_STAT( statUnget(q); )
     ++q->count;
     if (q->first == 0)
         q->first= q->buf_size - 1;
@@ -127,3 +317,96 @@ bool Q_full( const Queue* q )
 {
     return q->count == q->buf_size;
 }
+
+#endif // Q_POW2_IDX8
+
+
+/** Puts an item to the end of a queue if there is room.
+ * Unlike Q_put(), a full queue is not a caller error: the item is refused
+ * and counted in \c fullRejects of the statistics.
+ * @param[in,out] q the queue to add an item.
+ * @param[in] i the added item.
+ * @retval true if the item is put.
+ * @retval false if the queue is full.
+ */
+bool Q_tryPut( Queue* q, QueueItem i )
+{
+    if (Q_full(q)) {
+        Q_STAT( ++q->stats.fullRejects; )
+        return false;
+    }
+    Q_put(q, i);
+    return true;
+}
+
+
+/** Gets the first item of a queue if there is one.
+ * Unlike Q_get(), an empty queue is not a caller error: the get is refused
+ * and counted in \c emptyRejects of the statistics.
+ * @param[in,out] q the queue to get an item.
+ * @param[out] i the gotten item.
+ * @retval true if an item is gotten.
+ * @retval false if the queue is empty.
+ */
+bool Q_tryGet( Queue* q, QueueItem* i )
+{
+    if (Q_empty(q)) {
+        Q_STAT( ++q->stats.emptyRejects; )
+        return false;
+    }
+    *i= Q_get(q);
+    return true;
+}
+
+
+#if defined( Q_STATS )
+
+/** Returns the statistics of a queue. */
+const QueueStats* Q_stats( const Queue* q )
+{
+    return &q->stats;
+}
+
+
+/** Clears the statistics of a queue. */
+void Q_resetStats( Queue* q )
+{
+    memset(&q->stats, 0, sizeof(q->stats));
+    q->stats.highWater= Q_size(q);
+}
+
+
+/** Prints the statistics of a queue, e.g. from a menu command.
+ * @param[in] q the queue.
+ * @param[in] name the name shown in the heading.
+ */
+void Q_dumpStats( const Queue* q, const char* name )
+{
+    const QueueStats* s= &q->stats;
+    Idx8 k;
+
+#if Q_POW2_IDX8
+    printf("Queue %s: size %u/%u, high-water %u\n", name,
+           (unsigned)Q_size(q), (unsigned)q->mask + 1,
+           (unsigned)s->highWater);
+#else
+    printf("Queue %s: size %u/%u, high-water %u\n", name,
+           (unsigned)q->count, (unsigned)q->buf_size,
+           (unsigned)s->highWater);
+#endif
+    printf("  puts %lu, gets %lu, full rejects %u, empty rejects %u\n",
+           (unsigned long)s->puts, (unsigned long)s->gets,
+           (unsigned)s->fullRejects, (unsigned)s->emptyRejects);
+    printf("  latency (ms: samples):");
+    for (k=0; k<Q_LATENCY_BUCKETS; ++k) {
+        if (s->latency[k] == 0)
+            continue;
+        if (k == 0)
+            printf(" 0: %u", (unsigned)s->latency[k]);
+        else
+            printf(" <%u: %u", 1U << k, (unsigned)s->latency[k]);
+    }
+    printf("\n");
+}
+
+#endif // Q_STATS
@@ -13,16 +13,88 @@
 #include "platform.h"
 
 
+/** Selects the 8051-friendly variant of the queue at compile time.
+ *  - 1: The buffer size must be a power of two (at most 128). The indices
+ *       are 8-bit, run freely and wrap with a mask; no division is used.
+ *  - 0: Any buffer size; 16-bit indices wrap with '%'.
+ */
+#ifndef Q_POW2_IDX8
+    #define Q_POW2_IDX8 1
+#endif
+
+
 typedef char QueueItem; ///< the item type in a queue
 
+
+#if defined( Q_STATS )
+
+#ifndef Q_STATS_CLOCK
+    #include "timer.h"
+    /// Returns the current time in ticks for the latency histogram: the
+    /// 1 ms ticks of Time(), so Tick_init() must have been called.
+    #define Q_STATS_CLOCK()  ((QStatTick)Time())
+#endif
+
+typedef uint16_t QStatTick;     ///< tick type of Q_STATS_CLOCK(); wraps
+
+enum {
+    Q_LATENCY_BUCKETS= 8,       ///< buckets of the latency histogram
+    Q_LATENCY_SAMPLE_PERIOD= 16 ///< samples one of every this many puts
+};
+
+/** Occupancy and latency statistics of a queue. */
+typedef struct {
+    size_t highWater;           ///< the maximum size ever reached.
+    uint16_t fullRejects;       ///< items refused by a full queue.
+    uint16_t emptyRejects;      ///< items refused by an empty queue.
+    uint32_t puts;              ///< total items put.
+    uint32_t gets;              ///< total items gotten.
+
+    /// latency[k] counts samples of 2^(k-1) <= ticks < 2^k (k=0: 0 tick).
+    uint16_t latency[Q_LATENCY_BUCKETS];
+
+    bool sampling;              ///< whether a sampled item is in the queue.
+    size_t sampleAhead;         ///< the items ahead of the sample.
+    QStatTick sampleTick;       ///< the time the sample was put.
+} QueueStats;
+
+/// Executes statements only if the statistics are compiled in.
+#define Q_STAT( statement_list )  { statement_list }
+
+#else
+
+#define Q_STAT( statement_list )
+
+#endif // Q_STATS
+
+
+#if Q_POW2_IDX8
+
+typedef struct {
+    Idx8 first;     ///< free-running index of the first (front) item.
+    Idx8 end;       ///< free-running index of the end (last+1) item.
+    Idx8 mask;      ///< buffer size - 1.
+    QueueItem* buf; ///< a pointer that indicates the buffer of a queue.
+#if defined( Q_STATS )
+    QueueStats stats;   ///< the statistics of a queue.
+#endif
+} Queue;
+
+#else
+
 typedef struct {
     Index first;    ///< index of the first (front) item of a queue.
     Index end;      ///< index of the end (last+1) of a queue.
     size_t count;   ///< the number of items in a queue.
     QueueItem* buf; ///< a pointer that indicates the buffer of a queue.
     size_t buf_size;///< buffer size.
+#if defined( Q_STATS )
+    QueueStats stats;   ///< the statistics of a queue.
+#endif
 } Queue;
 
+#endif // Q_POW2_IDX8
+
 
 void Q_init( Queue* q, QueueItem* buf, size_t buf_size );
 void Q_clear( Queue* );
@@ -30,6 +102,9 @@ void Q_clear( Queue* );
 void Q_put( Queue*, QueueItem );
 QueueItem Q_get( Queue* );
 
+bool Q_tryPut( Queue*, QueueItem );
+bool Q_tryGet( Queue*, QueueItem* );
+
 QueueItem Q_unget( Queue* );
 
 QueueItem Q_first( const Queue* );
@@ -39,6 +114,15 @@ size_t Q_size( const Queue* );
 bool Q_empty( const Queue* );
 bool Q_full( const Queue* );
 
+#if defined( Q_STATS )
+    const QueueStats* Q_stats( const Queue* );
+    void Q_resetStats( Queue* );
+    void Q_dumpStats( const Queue*, const char* name );
+#else
+    #define Q_resetStats( q )           ((void)0)
+    #define Q_dumpStats( q, name )      ((void)0)
+#endif
+
 #endif // _QUEUE_H_
 
 /** @example Queue_test.c
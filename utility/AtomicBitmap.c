@@ -0,0 +1,178 @@
+/**
+ * @file AtomicBitmap.c
+ *      Implements a bitmap with atomic test-and-set, test-and-clear and
+ *      claim-a-clear-bit operations.
+ *
+ *      A claimed bit is set with acquire-release order and a cleared bit
+ *      with release order, so whatever a thread wrote to a slot before
+ *      releasing it is seen by the next thread that claims it.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see AtomicBitmap.h
+ * @see AtomicBitmap_test.c
+ */
+#include "assertions.h"
+#include "bitops.h"
+#include "AtomicBitmap.h"
+
+
+/// Returns the bit mask of a given bit index in its word
+#define BITMASK(i)  ((uint64_t)1 << ((i) % 64))
+
+
+/** Returns the mask of the bits of word[wi] that lie in the bitmap. */
+static uint64_t validMask(const AtomicBitmap* ab, size_t wi)
+{
+    const size_t rest = ab->nBits - wi * 64;
+
+    return LOW_MASK64(rest);
+}
+
+
+/** Claims a clear bit of word[wi] among the bits of \a allowed.
+ * @return the index of the bit in the word; -1 if none is clear.
+ */
+static int claimInWord(AtomicBitmap* ab, size_t wi, uint64_t allowed)
+{
+    uint64_t w = atomic_load_explicit(&ab->w[wi], memory_order_relaxed);
+    uint64_t free = ~w & allowed;
+
+    while (free != 0) {
+        const uint64_t bit = free & (~free + 1);    // the lowest clear bit
+
+        if (atomic_compare_exchange_weak_explicit(&ab->w[wi], &w, w | bit,
+                memory_order_acq_rel, memory_order_relaxed))
+            return (int)ctz64(bit);
+        free = ~w & allowed;    // w was reloaded by the failed exchange
+    }
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+/** Initializes an atomic bitmap with all bits clear. Not thread-safe.
+ * @param[out] ab the atomic bitmap
+ * @param[in] w the words; at least ATOMICBITMAP_WORDS(nBits)
+ * @param[in] nBits the number of bits
+ */
+void AtomicBitmap_init(AtomicBitmap* ab, AtomicBitmapWord w[], size_t nBits)
+{
+    size_t i;
+
+    ab->w = w;
+    ab->nBits = nBits;
+    for (i=0; i<ATOMICBITMAP_WORDS(nBits); ++i)
+        atomic_init(&w[i], 0);
+}
+
+
+/** Returns the total bits of the atomic bitmap. */
+size_t AtomicBitmap_totalBits(const AtomicBitmap* ab)
+{
+    return ab->nBits;
+}
+
+
+/** Sets bit[i] to 1 atomically. */
+void AtomicBitmap_setBit(AtomicBitmap* ab, Index i)
+{
+    ASSERT_OP (i, <, ab->nBits);
+
+    atomic_fetch_or_explicit(&ab->w[i / 64], BITMASK(i), memory_order_release);
+}
+
+
+/** Clears bit[i] to 0 atomically. */
+void AtomicBitmap_clrBit(AtomicBitmap* ab, Index i)
+{
+    ASSERT_OP (i, <, ab->nBits);
+
+    atomic_fetch_and_explicit(&ab->w[i / 64], ~BITMASK(i),
+                              memory_order_release);
+}
+
+
+/** Gets bit[i] */
+bool AtomicBitmap_getBit(AtomicBitmap* ab, Index i)
+{
+    ASSERT_OP (i, <, ab->nBits);
+
+    return (atomic_load_explicit(&ab->w[i / 64], memory_order_acquire)
+            & BITMASK(i)) != 0;
+}
+
+
+/** Sets bit[i] to 1 atomically, and returns its old value.
+ * @retval false if this call set the bit (e.g. claimed the slot).
+ * @retval true if the bit was already set.
+ */
+bool AtomicBitmap_testAndSet(AtomicBitmap* ab, Index i)
+{
+    ASSERT_OP (i, <, ab->nBits);
+
+    return (atomic_fetch_or_explicit(&ab->w[i / 64], BITMASK(i),
+                                     memory_order_acq_rel) & BITMASK(i)) != 0;
+}
+
+
+/** Clears bit[i] to 0 atomically, and returns its old value.
+ * @retval true if this call cleared the bit.
+ * @retval false if the bit was already clear (e.g. a double release).
+ */
+bool AtomicBitmap_testAndClr(AtomicBitmap* ab, Index i)
+{
+    ASSERT_OP (i, <, ab->nBits);
+
+    return (atomic_fetch_and_explicit(&ab->w[i / 64], ~BITMASK(i),
+                                      memory_order_acq_rel) & BITMASK(i)) != 0;
+}
+
+//-----------------------------------------------------------------------------
+
+/** Finds a sunk bit (value=0) in a ring-shaped bitmap and sets it, as one
+ *      atomic step per word.
+ *      - It first searches the bits in [\a begin, \em total);
+ *      - if not found, re-searches the bits in [\a 0, \a begin).
+ *
+ * @param[in,out] ab the atomic bitmap
+ * @param[in] begin the index of the \a begin search bit
+ * @return the index of the claimed bit;
+ * @return the total bits if all bits are set
+ */
+Index AtomicBitmap_claimSunkBit(AtomicBitmap* ab, Index begin)
+{
+    const size_t nWords = ATOMICBITMAP_WORDS(ab->nBits);
+    const size_t firstWordIdx = begin / 64;
+    size_t k;
+    int j;
+
+    ASSERT_OP (begin, <, ab->nBits);
+
+    // the first word twice: from begin at first, and below begin at last
+    for (k=0; k<=nWords; ++k) {
+        const size_t wi = (firstWordIdx + k) % nWords;
+        uint64_t allowed = validMask(ab, wi);
+
+        if (k == 0)
+            allowed &= ~LOW_MASK64(begin % 64);
+        else if (k == nWords)
+            allowed &= LOW_MASK64(begin % 64);
+        j = claimInWord(ab, wi, allowed);
+        if (j >= 0)
+            return wi * 64 + (Index)j;
+    }
+    return ab->nBits;
+}
+
+
+/** Counts the risen bits. It is a snapshot if other threads are running. */
+size_t AtomicBitmap_risenBitCount(AtomicBitmap* ab)
+{
+    size_t i, count = 0;
+
+    for (i=0; i<ATOMICBITMAP_WORDS(ab->nBits); ++i)
+        count += popcount64(atomic_load_explicit(&ab->w[i],
+                                                 memory_order_relaxed));
+    return count;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file AtomicBitmap.h
+ *      Interface of a bitmap whose bits are changed by atomic operations on
+ *      64-bit words, so that many threads can share it, e.g. to allocate
+ *      slots.
+ *
+ *      Bit \em i is bit (i % 64) of word (i / 64). A claim searches a clear
+ *      bit ringedly from a given start, as Bitmap_findSunkBitRingedly()
+ *      does, and sets it with a compare-and-swap; giving each thread its own
+ *      start (e.g. the bit after its last claim) spreads the threads over
+ *      different words, and so over different cache lines.
+ * @note Host only; needs C11 atomics.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see AtomicBitmap.c
+ * @see AtomicBitmap_test.c
+ * @see AtomicBitmap_bench.c
+ */
+#ifndef _ATOMIC_BITMAP_H_
+#define _ATOMIC_BITMAP_H_
+
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "platform.h"
+
+
+typedef _Atomic uint64_t AtomicBitmapWord;  ///< a word of an atomic bitmap
+
+/// Returns the number of words a bitmap of \a nb bits needs.
+#define ATOMICBITMAP_WORDS(nb)  (((nb) + 63) / 64)
+
+
+typedef struct {
+    AtomicBitmapWord* w;    ///< the words
+    size_t nBits;           ///< the number of bits
+} AtomicBitmap;
+
+
+void AtomicBitmap_init(AtomicBitmap*, AtomicBitmapWord w[], size_t nBits);
+size_t AtomicBitmap_totalBits(const AtomicBitmap*);
+
+void AtomicBitmap_setBit(AtomicBitmap*, Index i);
+void AtomicBitmap_clrBit(AtomicBitmap*, Index i);
+bool AtomicBitmap_getBit(AtomicBitmap*, Index i);
+
+bool AtomicBitmap_testAndSet(AtomicBitmap*, Index i);
+bool AtomicBitmap_testAndClr(AtomicBitmap*, Index i);
+
+Index AtomicBitmap_claimSunkBit(AtomicBitmap*, Index begin);
+size_t AtomicBitmap_risenBitCount(AtomicBitmap*);
+
+#endif // _ATOMIC_BITMAP_H_
+
+/** @example AtomicBitmap_test.c
+ *      This is an example of how to use the AtomicBitmap module.
+ */
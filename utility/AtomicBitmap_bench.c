@@ -0,0 +1,113 @@
+/**
+ * @file AtomicBitmap_bench.c
+ *      Measures slot allocation from a shared atomic bitmap.
+ *
+ *      Each of 1..N threads repeatedly claims a slot and releases it, with
+ *      the searches starting either all at slot 0 or at per-thread offsets,
+ *      and reports the throughput in claim + release pairs per second.
+ *      Usage: AtomicBitmap_bench [N [ops]]
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see AtomicBitmap.h
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "AtomicBitmap.h"
+
+enum {
+    NBITS= 4096,
+    HELD= 16,           ///< slots each thread keeps claimed
+    MAX_THREADS= 64
+};
+
+static AtomicBitmapWord words[ATOMICBITMAP_WORDS(NBITS)];
+static AtomicBitmap bitmap;
+
+/// Arguments of a worker thread
+typedef struct {
+    size_t ops;         ///< the number of claim + release pairs
+    Index cursor;       ///< where the searches start
+    int spread;         ///< moves the cursor after each claim
+} Worker;
+
+
+/** Claims and releases slots, keeping the last #HELD slots claimed. */
+static void* worker( void* arg )
+{
+    Worker* wk= (Worker*)arg;
+    Index held[HELD];
+    size_t n;
+
+    for (n=0; n<HELD; ++n)
+        held[n]= AtomicBitmap_claimSunkBit(&bitmap, wk->cursor);
+    for (n=0; n<wk->ops; ++n) {
+        const Index i= AtomicBitmap_claimSunkBit(&bitmap, wk->cursor);
+
+        if (i == NBITS)
+            abort();
+        AtomicBitmap_clrBit(&bitmap, held[n % HELD]);
+        held[n % HELD]= i;
+        if (wk->spread)
+            wk->cursor= (i + 1) % NBITS;
+    }
+    for (n=0; n<HELD; ++n)
+        AtomicBitmap_clrBit(&bitmap, held[n]);
+    return NULL;
+}
+
+
+static double now( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+/** Runs \a nt threads of \a ops operations each.
+ * @return operations per second
+ */
+static double run( int nt, size_t ops, int spread )
+{
+    pthread_t th[MAX_THREADS];
+    Worker wk[MAX_THREADS];
+    double t0, t1;
+    int t;
+
+    AtomicBitmap_init(&bitmap, words, NBITS);
+    t0= now();
+    for (t=0; t<nt; ++t) {
+        wk[t].ops= ops;
+        wk[t].cursor= spread ? (Index)t * NBITS / nt : 0;
+        wk[t].spread= spread;
+        pthread_create(&th[t], NULL, worker, &wk[t]);
+    }
+    for (t=0; t<nt; ++t)
+        pthread_join(th[t], NULL);
+    t1= now();
+
+    return ops * nt / (t1 - t0);
+}
+
+
+int main( int argc, char* argv[] )
+{
+    int n= (argc > 1) ? atoi(argv[1]) : 4;
+    size_t ops= (argc > 2) ? (size_t)atol(argv[2]) : 1000000;
+    int nt;
+
+    if (n < 1 || n > MAX_THREADS)
+        n= 4;
+
+    printf("ops/sec (claim + release)\n");
+    printf("%7s %14s %14s\n", "threads", "from slot 0", "per-thread");
+    for (nt=1; nt<=n; ++nt)
+        printf("%7d %14.0f %14.0f\n", nt, run(nt, ops, 0), run(nt, ops, 1));
+    return 0;
+}
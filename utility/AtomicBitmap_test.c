@@ -0,0 +1,94 @@
+/**
+ * @file AtomicBitmap_test.c
+ *      tests the atomic bitmap, and claims all bits from several threads.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see AtomicBitmap.h
+ * @see AtomicBitmap.c
+ */
+#include <pthread.h>
+#include <stdio.h>
+
+#include "AtomicBitmap.h"
+#include "ToyUnit.h"
+
+enum {
+    BITS= 100,              ///< a partial last word
+    MT_BITS= 4000,
+    MT_THREADS= 4
+};
+
+static AtomicBitmapWord w[ATOMICBITMAP_WORDS(BITS)];
+static AtomicBitmapWord mtWords[ATOMICBITMAP_WORDS(MT_BITS)];
+static AtomicBitmap mtBitmap;
+static int owner[MT_BITS];      ///< the thread that claimed each bit
+static size_t claims[MT_THREADS];
+
+
+/** Claims bits until none is left, starting at a per-thread offset. */
+static void* claimer( void* arg )
+{
+    const int t= (int)(size_t)arg;
+    Index cursor= (Index)t * MT_BITS / MT_THREADS;
+    Index i;
+
+    while ((i= AtomicBitmap_claimSunkBit(&mtBitmap, cursor)) != MT_BITS) {
+        owner[i]= t + 1;
+        ++claims[t];
+        cursor= (i + 1) % MT_BITS;
+    }
+    return NULL;
+}
+
+
+int main()
+{
+    AtomicBitmap ab;
+    pthread_t th[MT_THREADS];
+    size_t t, total= 0;
+    Index i;
+
+    AtomicBitmap_init(&ab, w, BITS);
+    TU_ASSERT("t1-1", AtomicBitmap_totalBits(&ab) == BITS);
+    TU_ASSERT("t1-2", AtomicBitmap_risenBitCount(&ab) == 0);
+    TU_ASSERT("t1-3", !AtomicBitmap_testAndSet(&ab, 70));
+    TU_ASSERT("t1-4", AtomicBitmap_testAndSet(&ab, 70));
+    TU_ASSERT("t1-5", AtomicBitmap_getBit(&ab, 70));
+    TU_ASSERT("t1-6", AtomicBitmap_testAndClr(&ab, 70));
+    TU_ASSERT("t1-7", !AtomicBitmap_testAndClr(&ab, 70));
+    AtomicBitmap_setBit(&ab, 3);
+    TU_ASSERT("t1-8", AtomicBitmap_getBit(&ab, 3));
+    AtomicBitmap_clrBit(&ab, 3);
+    TU_ASSERT("t1-9", !AtomicBitmap_getBit(&ab, 3));
+
+    TU_ASSERT("t2-1", AtomicBitmap_claimSunkBit(&ab, 5) == 5);
+    TU_ASSERT("t2-2", AtomicBitmap_claimSunkBit(&ab, 5) == 6);
+    TU_ASSERT("t2-3", AtomicBitmap_claimSunkBit(&ab, 99) == 99);
+    TU_ASSERT("t2-4", AtomicBitmap_claimSunkBit(&ab, 99) == 0);     // wraps
+    for (i=0; i<BITS; ++i)
+        AtomicBitmap_setBit(&ab, i);
+    AtomicBitmap_clrBit(&ab, 2);
+    TU_ASSERT("t2-5", AtomicBitmap_claimSunkBit(&ab, 50) == 2);
+    TU_ASSERT("t2-6", AtomicBitmap_claimSunkBit(&ab, 50) == BITS);
+    TU_ASSERT("t2-7", AtomicBitmap_risenBitCount(&ab) == BITS);
+    AtomicBitmap_clrBit(&ab, 60);
+    TU_ASSERT("t2-8", AtomicBitmap_claimSunkBit(&ab, 61) == 60);    // the start word, last
+
+    // every bit is claimed exactly once by the threads
+    AtomicBitmap_init(&mtBitmap, mtWords, MT_BITS);
+    for (t=0; t<MT_THREADS; ++t)
+        pthread_create(&th[t], NULL, claimer, (void*)t);
+    for (t=0; t<MT_THREADS; ++t) {
+        pthread_join(th[t], NULL);
+        total += claims[t];
+    }
+    TU_ASSERT("t3-1", total == MT_BITS);
+    TU_ASSERT("t3-2", AtomicBitmap_risenBitCount(&mtBitmap) == MT_BITS);
+    for (i=0; i<MT_BITS; ++i)
+        if (owner[i] == 0) break;
+    TU_ASSERT("t3-3", i == MT_BITS);
+
+    TU_RESULT();
+
+    return 0;
+}
@@ -2,18 +2,30 @@
  * @file Bitmap.c
  *      This module provides \em bitmap operations for byte-array.
  *      The bitmap is implemented with byte-array, each byte keeps 8 bits.
+ *      Defining \c BITMAP_SIMD routes the bulk scans through the SIMD
+ *      kernels of BitmapSimd.c. Defining \c BITMAP_BYTE_WORDS forces the
+ *      byte-word scans of 8-bit targets, to test them on a host.
  * @author Jiang Yu-Kuan <yukuan.jiang@gmail.com>
  * @date 2005/03/11 (initial)
- * @date 2016/01/16 (last revise)
- * @version 2.0
+ * @date 2026/10/17 (last revise)
+ * @version 2.1
  * @see Bitmap.h
  * @see Bitmap_test.c
  */
+#include <string.h>
 #include "assertions.h"
 
 #include "platform.h"
+#include "bitops.h"
 #include "Bitmap.h"
 
+#if defined(BITMAP_SIMD)
+    #include "BitmapSimd.h"
+
+    /// Ranges shorter than this are not worth a kernel call
+    #define SIMD_MIN_BITS   (8*64)
+#endif
+
 
 /// Returns the slot index of a given bit index
 #define BITSLOT(b)  ((b) / ELEM_BITS)
@@ -22,6 +34,106 @@
 #define BITMASK(b)  (1 << ((b) % ELEM_BITS))
 
 
+// Scans run a machine word at a time where the compiler has 64-bit
+// integers; elsewhere (e.g. Keil C51) a word is a byte.
+#if defined(UINT64_MAX) && !defined(BITMAP_BYTE_WORDS)
+    typedef uint64_t Word;
+    #define WORD_BITS       64
+    #define POPCOUNT(w)     popcount64(w)
+    #define CTZ(w)          ctz64(w)
+    #define MSB(w)          msb64(w)
+#else
+    typedef Byte Word;
+    #define WORD_BITS       8
+    #define POPCOUNT(w)     popcount8(w)
+
+    /** Returns the number of set bits of a byte. */
+    static Byte popcount8(Byte x)
+    {
+        x = x - ((x >> 1) & 0x55);
+        x = (x & 0x33) + ((x >> 2) & 0x33);
+        return (x + (x >> 4)) & 0x0F;
+    }
+
+    /** Returns the index of the lowest set bit of a non-zero byte. */
+    static Byte ctz8(Byte x)
+    {
+        return popcount8((Byte)((x & -x) - 1));
+    }
+
+    /** Returns the index of the highest set bit of a non-zero byte. */
+    static Byte msb8(Byte x)
+    {
+        x |= x >> 1;
+        x |= x >> 2;
+        x |= x >> 4;
+        return popcount8(x) - 1;
+    }
+
+    #define CTZ(w)          ctz8(w)
+    #define MSB(w)          msb8(w)
+#endif
+
+/// A word of all 1s. The cast keeps a byte word from being promoted to
+/// int, where ~0 would be -1 and the shifts below would misbehave.
+#define WORD_ONES       ((Word)~(Word)0)
+
+/// Returns a word mask of bits [\a r, WORD_BITS) (0 <= r < WORD_BITS)
+#define HEAD_MASK(r)    ((Word)(WORD_ONES << (r)))
+
+/// Returns a word mask of bits [0, \a n) (0 < n <= WORD_BITS)
+#define TAIL_MASK(n)    ((Word)(WORD_ONES >> (WORD_BITS - (n))))
+
+
+/** Loads word[wi] of a bitmap: bit \em j of the word is bit
+ *      (wi*WORD_BITS + j) of the bitmap. Bytes beyond the bitmap read as 0.
+ */
+static Word loadWord(const Bitmap* b, Index wi)
+{
+#if WORD_BITS == 64
+    const size_t at = wi * 8;
+
+    if (at + 8 <= b->n)
+        return load64le(b->a + at);
+    return loadPartial64le(b->a + at, b->n - at);
+#else
+    return b->a[wi];
+#endif
+}
+
+
+// Whole words at a byte address, for the set operators
+#if WORD_BITS == 64
+    #define WORD_AT(p)          load64le(p)
+    #define SET_WORD_AT(p, w)   store64le(p, w)
+#else
+    #define WORD_AT(p)          (*(p))
+    #define SET_WORD_AT(p, w)   (*(p) = (w))
+#endif
+
+/// Combines bitmaps \a x and \a y into \a tgt a word at a time by a binary
+/// operator macro \a OP; the bytes after the last whole word one by one.
+/// The fields are read into locals first: stores through a byte pointer
+/// may alias them, which would keep the compiler from vectorizing.
+#define COMBINE(x, y, tgt, OP)                                              \
+    do {                                                                    \
+        const Byte* xa_ = (x)->a;                                           \
+        const Byte* ya_ = (y)->a;                                           \
+        Byte* ta_ = (tgt)->a;                                               \
+        const size_t n_ = (x)->n;                                           \
+        Index i_;                                                           \
+        for (i_=0; i_+sizeof(Word)<=n_; i_+=sizeof(Word))                   \
+            SET_WORD_AT(ta_ + i_, OP(WORD_AT(xa_ + i_), WORD_AT(ya_ + i_)));\
+        for (; i_<n_; ++i_)                                                 \
+            ta_[i_] = (Byte)OP(xa_[i_], ya_[i_]);                           \
+    } while (0)
+
+#define OP_AND(p, q)        ((p) & (q))
+#define OP_OR(p, q)         ((p) | (q))
+#define OP_XOR(p, q)        ((p) ^ (q))
+#define OP_ANDNOT(p, q)     ((p) & ~(q))
+
+
 //-----------------------------------------------------------------------------
 // Bit-wise operators
 //-----------------------------------------------------------------------------
@@ -88,52 +200,157 @@ Bit Bitmap_getBit(const Bitmap* b, Index i)
 /** Sets all bits to zero. */
 void Bitmap_clearAllBits(Bitmap* b)
 {
-    Index i;
-    for (i=0; i<b->n; ++i)
-        b->a[i] = 0;
+    memset(b->a, 0, b->n);
 }
 
 
 /** Copies bits from \a src to \a tgt. */
 void Bitmap_copyAllBits(const Bitmap* src, Bitmap* tgt)
 {
-    Index i;
-
     ASSERT_OP (src->n, ==, tgt->n);
 
-    for (i=0; i<src->n; ++i)
-        tgt->a[i] = src->a[i];
+    memcpy(tgt->a, src->a, src->n);
+}
+
+//-----------------------------------------------------------------------------
+
+/** Sets or clears the bits in [\a begin, \a end): the partial end bytes
+ *      by masks, the whole bytes between them by memset().
+ */
+static void fillRange(Bitmap* b, Index begin, Index end, Bit val)
+{
+    Index firstByteIdx, lastByteIdx;
+    Byte headMask, tailMask;
+
+    ASSERT_OP (begin, <=, end);
+    ASSERT_OP (end, <=, Bitmap_totalBits(b));
+
+    if (begin == end)
+        return;
+
+    firstByteIdx = begin / ELEM_BITS;
+    lastByteIdx = (end-1) / ELEM_BITS;
+    headMask = (Byte)(0xFF << (begin % ELEM_BITS));
+    tailMask = (Byte)(0xFF >> (ELEM_BITS-1 - (end-1) % ELEM_BITS));
+
+    if (firstByteIdx == lastByteIdx) {
+        headMask &= tailMask;
+        if (val)
+            b->a[firstByteIdx] |= headMask;
+        else
+            b->a[firstByteIdx] &= ~headMask;
+        return;
+    }
+
+    if (val) {
+        b->a[firstByteIdx] |= headMask;
+        b->a[lastByteIdx] |= tailMask;
+    } else {
+        b->a[firstByteIdx] &= ~headMask;
+        b->a[lastByteIdx] &= ~tailMask;
+    }
+    memset(b->a + firstByteIdx + 1, val ? 0xFF : 0x00,
+           lastByteIdx - firstByteIdx - 1);
+}
+
+
+/** Sets the bits in the range [\a begin, \a end) to 1.
+ * @param[out] b the bitmap
+ * @param[in] begin the index of the \a begin set bit
+ * @param[in] end the \em limit index of the set bits (= \em last+1).
+ * @see Bitmap_clrRange()
+ */
+void Bitmap_setRange(Bitmap* b, Index begin, Index end)
+{
+    fillRange(b, begin, end, true);
+}
+
+
+/** Clears the bits in the range [\a begin, \a end) to 0.
+ * @param[out] b the bitmap
+ * @param[in] begin the index of the \a begin cleared bit
+ * @param[in] end the \em limit index of the cleared bits (= \em last+1).
+ * @see Bitmap_setRange()
+ */
+void Bitmap_clrRange(Bitmap* b, Index begin, Index end)
+{
+    fillRange(b, begin, end, false);
 }
 
 //-----------------------------------------------------------------------------
 
 /** Counts the total risen bit (value=1)
- *      in the range [\em 0, \a end) of a give bitmap.
+ *      in the range [\a begin, \a end) of a give bitmap.
+ *      It counts a word at a time; the partial head and tail words are
+ *      masked.
  * @param b the bitmap
+ * @param begin the index of the \a begin counted bit
  * @param end the \em limit index of the counted bits (= \em last+1).
  * @return the count result
- * @see Bitmap_sunkBitCount()
+ * @see Bitmap_sunkBitCountInRange()
  */
-size_t Bitmap_risenBitCount(const Bitmap* b, Index end)
+size_t Bitmap_risenBitCountInRange(const Bitmap* b, Index begin, Index end)
 {
-    Index i; // index of byte in the byte-array
-    Index j; // index of bit in a byte
-    const Index lastByteIdx = (end-1)/ELEM_BITS;
-    size_t restBits = end;
+    Index wi;   // index of word
+    Index lastWordIdx;
+    Word w;
     size_t result = 0;
 
-    for (i=0; i<=lastByteIdx; i++) {
-        if (b->a[i] != 0) {
-            Byte byte = b->a[i];
-            Byte bits = (restBits<ELEM_BITS) ? restBits : ELEM_BITS;
-            for (j=0; j<bits; j++) {
-                result += byte & 0x1;
-                byte >>= 1;
-            }
-        }
-        restBits -= ELEM_BITS;
+    ASSERT_OP (begin, <=, end);
+    ASSERT_OP (end, <=, Bitmap_totalBits(b));
+
+    if (begin == end)
+        return 0;
+
+#if defined(BITMAP_SIMD)
+    // Counts the whole bytes by the kernel; the partial ends by words.
+    if (end - begin >= SIMD_MIN_BITS) {
+        const Index beginByteIdx = (begin + 7) / 8;
+        const Index endByteIdx = end / 8;
+
+        return Bitmap_risenBitCountInRange(b, begin, beginByteIdx*8)
+             + BS_kernels()->popcount(b->a + beginByteIdx,
+                                      endByteIdx - beginByteIdx)
+             + Bitmap_risenBitCountInRange(b, endByteIdx*8, end);
     }
-    return result;
+#endif
+
+    wi = begin / WORD_BITS;
+    lastWordIdx = (end-1) / WORD_BITS;
+    w = loadWord(b, wi) & HEAD_MASK(begin % WORD_BITS);
+    while (wi < lastWordIdx) {
+        result += POPCOUNT(w);
+        w = loadWord(b, ++wi);
+    }
+    w &= TAIL_MASK(end - lastWordIdx*WORD_BITS);
+    return result + POPCOUNT(w);
+}
+
+
+/** Counts the total sunk bit (value=0)
+ *      in the range [\a begin, \a end) of a give bitmap.
+ * @param b the bitmap
+ * @param begin the index of the \a begin counted bit
+ * @param end the \em limit index of the counted bits (= \em last+1).
+ * @return the count result
+ * @see Bitmap_risenBitCountInRange()
+ */
+size_t Bitmap_sunkBitCountInRange(const Bitmap* b, Index begin, Index end)
+{
+    return (end - begin) - Bitmap_risenBitCountInRange(b, begin, end);
+}
+
+
+/** Counts the total risen bit (value=1)
+ *      in the range [\em 0, \a end) of a give bitmap.
+ * @param b the bitmap
+ * @param end the \em limit index of the counted bits (= \em last+1).
+ * @return the count result
+ * @see Bitmap_sunkBitCount()
+ */
+size_t Bitmap_risenBitCount(const Bitmap* b, Index end)
+{
+    return Bitmap_risenBitCountInRange(b, 0, end);
 }
 
 
@@ -150,6 +367,113 @@ size_t Bitmap_sunkBitCount(const Bitmap* b, Index end)
 }
 
 
+/** Finds the 1st bit that differs from \a flip in [\a begin, \a end).
+ *      Words that hold no such bit (all 0s, or all 1s when searching for a
+ *      sunk bit) are skipped whole; the bit is located by ctz.
+ * @param flip 0 to find a risen bit; ~0 to find a sunk bit.
+ * @return the index of the found bit; \a end if not found
+ */
+static Index findFirst(const Bitmap* b, Index begin, Index end, Word flip)
+{
+    Index wi;   // index of word
+    Index lastWordIdx;
+    Word w;
+
+    ASSERT_OP (begin, <=, end);
+    ASSERT_OP (end, <=, Bitmap_totalBits(b));
+
+    if (begin == end)
+        return end;
+
+    wi = begin / WORD_BITS;
+    lastWordIdx = (end-1) / WORD_BITS;
+    w = (loadWord(b, wi) ^ flip) & HEAD_MASK(begin % WORD_BITS);
+    for (;;) {
+        if (wi == lastWordIdx) {
+            w &= TAIL_MASK(end - wi*WORD_BITS);
+            break;
+        }
+        if (w != 0)
+            break;
+        w = loadWord(b, ++wi) ^ flip;
+    }
+    return (w != 0) ? wi*WORD_BITS + CTZ(w) : end;
+}
+
+
+/** Finds the last bit that differs from \a flip in [\a begin, \a end).
+ * @param flip 0 to find a risen bit; ~0 to find a sunk bit.
+ * @return the index of the found bit; \a end if not found
+ * @see findFirst()
+ */
+static Index findLast(const Bitmap* b, Index begin, Index end, Word flip)
+{
+    Index wi;   // index of word
+    Index firstWordIdx;
+    Word w;
+
+    ASSERT_OP (begin, <=, end);
+    ASSERT_OP (end, <=, Bitmap_totalBits(b));
+
+    if (begin == end)
+        return end;
+
+    wi = (end-1) / WORD_BITS;
+    firstWordIdx = begin / WORD_BITS;
+    w = (loadWord(b, wi) ^ flip) & TAIL_MASK(end - wi*WORD_BITS);
+    for (;;) {
+        if (wi == firstWordIdx) {
+            w &= HEAD_MASK(begin % WORD_BITS);
+            break;
+        }
+        if (w != 0)
+            break;
+        w = loadWord(b, --wi) ^ flip;
+    }
+    return (w != 0) ? wi*WORD_BITS + MSB(w) : end;
+}
+
+
+/** Finds a bit that differs from \a flip in a ring-shaped bitmap, searching
+ *      [\a begin, \a end) and then [\em 0, \a begin).
+ * @return the index of the found bit; \a end if not found
+ */
+static Index findFirstRingedly(const Bitmap* b, Index begin, Index end,
+                               Word flip)
+{
+    Index i = findFirst(b, begin, end, flip);
+    if (i == end) {
+        i = findFirst(b, 0, begin, flip);
+        if (i == begin)
+            return end;
+    }
+    return i;
+}
+
+
+/** Finds a bit that differs from \a flip in a ring-shaped bitmap, searching
+ *      downwards from \a begin through \em 0, and then from \a end-1 down to
+ *      \a begin+1.
+ * @return the index of the found bit; \a end if not found
+ */
+static Index findLastRingedly(const Bitmap* b, Index begin, Index end,
+                              Word flip)
+{
+    Index i;
+
+    ASSERT_OP (begin, <, end);
+
+    i = findLast(b, 0, begin+1, flip);
+    if (i == begin+1) {
+        i = findLast(b, begin+1, end, flip);
+        if (i == end)
+            return end;
+    }
+    return i;
+}
+
+//-----------------------------------------------------------------------------
+
 /** Finds the 1st risen bit (value=1)
  *      in the range [\a begin, \a end) of a give bitmap.
  * @param b the bitmap
@@ -157,49 +481,54 @@ size_t Bitmap_sunkBitCount(const Bitmap* b, Index end)
  * @param end the \em limit index of the searched bits (= \em last+1).
  * @return the index of the found risen bit;
  * @return \a end if not found
+ * @see Bitmap_findSunkBit()
  */
 Index Bitmap_findRisenBit(const Bitmap* b, Index begin, Index end)
 {
-    Index i; // index of byte in the byte-array
-    Index j; // index of bit int a byte
-    const Index beginByteIdx = begin/ELEM_BITS;
-    const Index lastByteIdx = (end-1)/ELEM_BITS;
-    Byte r;  // remainder
-
-    assert (begin < end);
-
-    // To search the prefix head bits, which
-    //   may be a whole or non-wole byte
-    r = begin%ELEM_BITS;
-    if (b->a[beginByteIdx] != 0) {
-        Byte byte = b->a[beginByteIdx] >> r;
-        for (j=r; j<ELEM_BITS; j++) {
-            if (byte & 0x1) {
-                assert ((begin+j-r) < end);
-                return begin + j - r;
-            }
-            byte >>= 1;
-        }
-    }
+    return findFirst(b, begin, end, 0);
+}
 
-    // To search the bits of body whole-bytes and tail bits.
-    for (i=beginByteIdx+1; i<=lastByteIdx; i++) {
-        if (b->a[i] != 0) {
-            Byte byte = b->a[i];
-            size_t restBits = (end - begin)
-                             - (i-(beginByteIdx+1)) * ELEM_BITS
-                             - (ELEM_BITS - r);
-            Byte bits = (restBits<ELEM_BITS) ? restBits : ELEM_BITS;
-            for (j=0; j<bits; j++) {
-                if (byte & 0x1) {
-                    assert ((i*ELEM_BITS + j)<end);
-                    return i*ELEM_BITS + j;
-                }
-                byte >>= 1;
-            }
-        }
-    }
-    return end;
+
+/** Finds the 1st sunk bit (value=0)
+ *      in the range [\a begin, \a end) of a give bitmap.
+ * @param b the bitmap
+ * @param begin the index of the \a begin search bit
+ * @param end the \em limit index of the searched bits (= \em last+1).
+ * @return the index of the found sunk bit;
+ * @return \a end if not found
+ * @see Bitmap_findRisenBit()
+ */
+Index Bitmap_findSunkBit(const Bitmap* b, Index begin, Index end)
+{
+    return findFirst(b, begin, end, WORD_ONES);
+}
+
+
+/** Finds the last risen bit (value=1)
+ *      in the range [\a begin, \a end) of a give bitmap.
+ * @param b the bitmap
+ * @param begin the index of the \a begin search bit
+ * @param end the \em limit index of the searched bits (= \em last+1).
+ * @return the index of the found risen bit;
+ * @return \a end if not found
+ */
+Index Bitmap_findLastRisenBit(const Bitmap* b, Index begin, Index end)
+{
+    return findLast(b, begin, end, 0);
+}
+
+
+/** Finds the last sunk bit (value=0)
+ *      in the range [\a begin, \a end) of a give bitmap.
+ * @param b the bitmap
+ * @param begin the index of the \a begin search bit
+ * @param end the \em limit index of the searched bits (= \em last+1).
+ * @return the index of the found sunk bit;
+ * @return \a end if not found
+ */
+Index Bitmap_findLastSunkBit(const Bitmap* b, Index begin, Index end)
+{
+    return findLast(b, begin, end, WORD_ONES);
 }
 
 
@@ -215,13 +544,177 @@ Index Bitmap_findRisenBit(const Bitmap* b, Index begin, Index end)
  */
 Index Bitmap_findRisenBitRingedly(const Bitmap* b, Index begin, Index end)
 {
-    Index i = Bitmap_findRisenBit(b, begin, end);
-    if (i == end) {
-        i = Bitmap_findRisenBit(b, 0, begin);
-        if (i == begin)
-            return end;
-    }
-    return i;
+    return findFirstRingedly(b, begin, end, 0);
+}
+
+
+/** Finds a sunk bit (value=0) in a ring-shaped bitmap.
+ *      - It first searches the bits in [\a begin, \a end);
+ *      - if not found, re-searches the bits in [\a 0, \a begin).
+ *
+ * @param b the bitmap
+ * @param begin the index of the \a begin search bit
+ * @param end the \em limit index of the searched bits (= \em last+1).
+ * @return the index of the found sunk bit;
+ * @return \a end if not found
+ */
+Index Bitmap_findSunkBitRingedly(const Bitmap* b, Index begin, Index end)
+{
+    return findFirstRingedly(b, begin, end, WORD_ONES);
+}
+
+
+/** Finds a risen bit (value=1) backwards in a ring-shaped bitmap.
+ *      - It first searches the bits in [\a 0, \a begin] from \a begin down;
+ *      - if not found, re-searches the bits in (\a begin, \a end) from
+ *        \a end-1 down.
+ *
+ * @param b the bitmap
+ * @param begin the index of the \a begin search bit
+ * @param end the \em limit index of the searched bits (= \em last+1).
+ * @return the index of the found risen bit;
+ * @return \a end if not found
+ */
+Index Bitmap_findLastRisenBitRingedly(const Bitmap* b, Index begin, Index end)
+{
+    return findLastRingedly(b, begin, end, 0);
+}
+
+
+/** Finds a sunk bit (value=0) backwards in a ring-shaped bitmap.
+ *      - It first searches the bits in [\a 0, \a begin] from \a begin down;
+ *      - if not found, re-searches the bits in (\a begin, \a end) from
+ *        \a end-1 down.
+ *
+ * @param b the bitmap
+ * @param begin the index of the \a begin search bit
+ * @param end the \em limit index of the searched bits (= \em last+1).
+ * @return the index of the found sunk bit;
+ * @return \a end if not found
+ */
+Index Bitmap_findLastSunkBitRingedly(const Bitmap* b, Index begin, Index end)
+{
+    return findLastRingedly(b, begin, end, WORD_ONES);
+}
+
+//-----------------------------------------------------------------------------
+
+/** Determines if all bits in the range [\a begin, \a end) are risen.
+ *      An empty range is all risen.
+ * @see Bitmap_isRangeClear()
+ */
+bool Bitmap_isRangeSet(const Bitmap* b, Index begin, Index end)
+{
+    return findFirst(b, begin, end, WORD_ONES) == end;
+}
+
+
+/** Determines if all bits in the range [\a begin, \a end) are sunk.
+ *      An empty range is all sunk.
+ * @see Bitmap_isRangeSet()
+ */
+bool Bitmap_isRangeClear(const Bitmap* b, Index begin, Index end)
+{
+    return findFirst(b, begin, end, 0) == end;
+}
+
+
+//-----------------------------------------------------------------------------
+// Set operators
+//-----------------------------------------------------------------------------
+
+/** Stores the intersection (\a x AND \a y) of two bitmaps to \a tgt.
+ *      \a tgt may be \a x or \a y, to operate in place.
+ * @param[in] x a bitmap
+ * @param[in] y a bitmap of the same size as \a x
+ * @param[out] tgt the result; of the same size as \a x
+ */
+void Bitmap_and(const Bitmap* x, const Bitmap* y, Bitmap* tgt)
+{
+    ASSERT_OP (x->n, ==, y->n);
+    ASSERT_OP (x->n, ==, tgt->n);
+
+    COMBINE(x, y, tgt, OP_AND);
+}
+
+
+/** Stores the union (\a x OR \a y) of two bitmaps to \a tgt.
+ *      \a tgt may be \a x or \a y, to operate in place.
+ * @see Bitmap_and()
+ */
+void Bitmap_or(const Bitmap* x, const Bitmap* y, Bitmap* tgt)
+{
+    ASSERT_OP (x->n, ==, y->n);
+    ASSERT_OP (x->n, ==, tgt->n);
+
+    COMBINE(x, y, tgt, OP_OR);
+}
+
+
+/** Stores the symmetric difference (\a x XOR \a y) of two bitmaps to
+ *      \a tgt. \a tgt may be \a x or \a y, to operate in place.
+ * @see Bitmap_and()
+ */
+void Bitmap_xor(const Bitmap* x, const Bitmap* y, Bitmap* tgt)
+{
+    ASSERT_OP (x->n, ==, y->n);
+    ASSERT_OP (x->n, ==, tgt->n);
+
+    COMBINE(x, y, tgt, OP_XOR);
+}
+
+
+/** Stores the difference (\a x AND NOT \a y) of two bitmaps to \a tgt.
+ *      \a tgt may be \a x or \a y, to operate in place.
+ * @see Bitmap_and()
+ */
+void Bitmap_andNot(const Bitmap* x, const Bitmap* y, Bitmap* tgt)
+{
+    ASSERT_OP (x->n, ==, y->n);
+    ASSERT_OP (x->n, ==, tgt->n);
+
+    COMBINE(x, y, tgt, OP_ANDNOT);
+}
+
+
+/** Counts the risen bits of (\a x AND \a y) without storing it.
+ * @param[in] x a bitmap
+ * @param[in] y a bitmap of the same size as \a x
+ * @return the size of the intersection
+ */
+size_t Bitmap_andCount(const Bitmap* x, const Bitmap* y)
+{
+    Index i;
+    size_t result = 0;
+
+    ASSERT_OP (x->n, ==, y->n);
+
+    for (i=0; i+sizeof(Word)<=x->n; i+=sizeof(Word))
+        result += POPCOUNT(WORD_AT(x->a + i) & WORD_AT(y->a + i));
+    for (; i<x->n; ++i)
+        result += POPCOUNT((Word)(x->a[i] & y->a[i]));
+    return result;
+}
+
+
+/** Determines if two bitmaps have a risen bit in common. It stops at the
+ *      first common word.
+ * @param[in] x a bitmap
+ * @param[in] y a bitmap of the same size as \a x
+ */
+bool Bitmap_intersects(const Bitmap* x, const Bitmap* y)
+{
+    Index i;
+
+    ASSERT_OP (x->n, ==, y->n);
+
+    for (i=0; i+sizeof(Word)<=x->n; i+=sizeof(Word))
+        if ((WORD_AT(x->a + i) & WORD_AT(y->a + i)) != 0)
+            return true;
+    for (; i<x->n; ++i)
+        if ((x->a[i] & y->a[i]) != 0)
+            return true;
+    return false;
 }
 
 
@@ -267,11 +760,17 @@ Index Bitmap_findRisenByte(const Bitmap* b, Index begin, Index end)
 {
     cassert (ELEM_BITS == 8);
 
-    Index i;
+#if defined(BITMAP_SIMD)
+    return begin + BS_kernels()->findByte(b->a + begin, end - begin, 0xFF);
+#else
+    {
+        Index i;
 
-    for (i=begin; i<end; i++)
-        if (b->a[i] == 0xFF) break;
-    return i;
+        for (i=begin; i<end; i++)
+            if (b->a[i] == 0xFF) break;
+        return i;
+    }
+#endif
 }
 
 
@@ -352,26 +851,27 @@ Elem Bitmap_maxPartValue(const Bitmap* b)
 }
 
 
-/** Sets part[i] to a value
+/** Sets part[i] to a value. A part lies in at most two bytes, which are
+ *      updated by masks.
  * @param[out] b the bitmap
  * @param[in] i the index of the \em bits to be set
  * @param[in] val the value to set
  */
 void Bitmap_setPart(Bitmap* b, Index i, Elem val)
 {
-    Index bit_idx;
-    Index begin = i*b->p;
-    Index end = begin + b->p;
+    const Index begin = i*b->p;
+    const Index byteIdx = begin / ELEM_BITS;
+    const unsigned shift = begin % ELEM_BITS;
+    const unsigned mask = ((1u << b->p) - 1) << shift;
+    const unsigned bits = (unsigned)val << shift;
 
     ASSERT_OP (i, <, Bitmap_totalParts(b));
     ASSERT_OP (val, <=, Bitmap_maxPartValue(b));
 
-    for (bit_idx=begin; bit_idx<end; ++bit_idx) {
-        if (val & 0x00000001)
-            Bitmap_setBit(b, bit_idx);
-        else
-            Bitmap_clrBit(b, bit_idx);
-        val >>= 1;
+    b->a[byteIdx] = (Byte)((b->a[byteIdx] & ~mask) | bits);
+    if (shift + b->p > ELEM_BITS) {
+        b->a[byteIdx+1] = (Byte)((b->a[byteIdx+1] & ~(mask >> ELEM_BITS))
+                                 | (bits >> ELEM_BITS));
     }
 }
 
@@ -383,33 +883,53 @@ void Bitmap_setPart(Bitmap* b, Index i, Elem val)
  */
 Elem Bitmap_getPart(const Bitmap* b, Index i)
 {
-    Index begin = i*b->p;
-    Index end = begin + b->p;
-    Index bit_idx = end;
-    Elem val = 0;
+    const Index begin = i*b->p;
+    const Index byteIdx = begin / ELEM_BITS;
+    const unsigned shift = begin % ELEM_BITS;
+    unsigned val;
 
     ASSERT_OP (i, <, Bitmap_totalParts(b));
 
-    for (;;) {
-        val |= Bitmap_getBit(b, --bit_idx);
-        if (bit_idx == begin)
-            break;
-        val <<= 1;
-    }
-
-    return val;
+    val = (unsigned)b->a[byteIdx] >> shift;
+    if (shift + b->p > ELEM_BITS)
+        val |= (unsigned)b->a[byteIdx+1] << (ELEM_BITS - shift);
+    return (Elem)(val & ((1u << b->p) - 1));
 }
 
 
 /** Fills all partitions with a given value.
+ *      The parts repeat every lcm(p, 8) bits, a whole number of bytes. One
+ *      period is set part by part, and then copied with doubling memcpy()s;
+ *      the parts in the last partial byte are set one by one, so the bits
+ *      after the last part keep their values.
  * @param[in] b the bitmap
  * @param[in] val the value to fill
  */
 void Bitmap_fillAllParts(Bitmap* b, Elem val)
 {
+    const size_t nParts = Bitmap_totalParts(b);
+    const size_t nBytes = nParts * b->p / ELEM_BITS;    // whole bytes of parts
+    size_t period = b->p;   // lcm(p, 8) / 8 bytes
+    size_t done;
     Index i;
 
-    for (i=0; i<Bitmap_totalParts(b); ++i)
+    while (period % ELEM_BITS != 0)
+        period += b->p;
+    period /= ELEM_BITS;
+
+    if (nBytes < period) {
+        for (i=0; i<nParts; ++i)
+            Bitmap_setPart(b, i, val);
+        return;
+    }
+
+    for (i=0; i<period*ELEM_BITS/b->p; ++i)
+        Bitmap_setPart(b, i, val);
+    for (done=period; done<nBytes; done*=2) {
+        memcpy(b->a + done, b->a,
+               (2*done <= nBytes) ? done : nBytes - done);
+    }
+    for (i=nBytes*ELEM_BITS/b->p; i<nParts; ++i)
         Bitmap_setPart(b, i, val);
 }
 
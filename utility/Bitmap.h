@@ -3,8 +3,8 @@
  *      This module provides \em bitmap operations for byte-array.
  * @author Jiang Yu-Kuan <yukuan.jiang@gmail.com>
  * @date 2005/03/12 (initial)
- * @date 2016/01/15 (last revise)
- * @version 1.5
+ * @date 2026/10/17 (last revise)
+ * @version 1.6
  * @see Bitmap.c
  * @see Bitmap_test.c
  */
@@ -44,13 +44,37 @@ Bit Bitmap_getBit(const Bitmap*, Index i);
 void Bitmap_clearAllBits(Bitmap*);
 void Bitmap_copyAllBits(const Bitmap* src, Bitmap* tgt);
 
+void Bitmap_setRange(Bitmap*, Index begin, Index end);
+void Bitmap_clrRange(Bitmap*, Index begin, Index end);
+bool Bitmap_isRangeSet(const Bitmap*, Index begin, Index end);
+bool Bitmap_isRangeClear(const Bitmap*, Index begin, Index end);
+
 //----------------------------------------------------------------------------
 
 size_t Bitmap_risenBitCount(const Bitmap*, Index end);
 size_t Bitmap_sunkBitCount(const Bitmap*, Index end);
+size_t Bitmap_risenBitCountInRange(const Bitmap*, Index begin, Index end);
+size_t Bitmap_sunkBitCountInRange(const Bitmap*, Index begin, Index end);
 
 Index Bitmap_findRisenBit(const Bitmap*, Index begin, Index end);
 Index Bitmap_findRisenBitRingedly(const Bitmap*, Index begin, Index end);
+Index Bitmap_findSunkBit(const Bitmap*, Index begin, Index end);
+Index Bitmap_findSunkBitRingedly(const Bitmap*, Index begin, Index end);
+
+Index Bitmap_findLastRisenBit(const Bitmap*, Index begin, Index end);
+Index Bitmap_findLastRisenBitRingedly(const Bitmap*, Index begin, Index end);
+Index Bitmap_findLastSunkBit(const Bitmap*, Index begin, Index end);
+Index Bitmap_findLastSunkBitRingedly(const Bitmap*, Index begin, Index end);
+
+//----------------------------------------------------------------------------
+
+void Bitmap_and(const Bitmap* x, const Bitmap* y, Bitmap* tgt);
+void Bitmap_or(const Bitmap* x, const Bitmap* y, Bitmap* tgt);
+void Bitmap_xor(const Bitmap* x, const Bitmap* y, Bitmap* tgt);
+void Bitmap_andNot(const Bitmap* x, const Bitmap* y, Bitmap* tgt);
+
+size_t Bitmap_andCount(const Bitmap* x, const Bitmap* y);
+bool Bitmap_intersects(const Bitmap* x, const Bitmap* y);
 
 //----------------------------------------------------------------------------
 
@@ -0,0 +1,266 @@
+/**
+ * @file BitmapSimd.c
+ *      Implements SIMD kernels for bulk bitmap scans, and the selection of
+ *      them by the features the CPU reports at run time.
+ *
+ *      Each x86 kernel is compiled for its own instruction set with the
+ *      \c target attribute, so the module builds with default flags and
+ *      still runs on a CPU without AVX.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see BitmapSimd.h
+ * @see BitmapSimd_test.c
+ */
+#include <stdint.h>
+#include "bitops.h"
+#include "BitmapSimd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define BS_X86  1
+    #include <immintrin.h>
+#else
+    #define BS_X86  0
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Scalar reference
+//-----------------------------------------------------------------------------
+
+static size_t scalarFindByte(const Byte a[], size_t n, Byte val)
+{
+    size_t i;
+
+    for (i=0; i<n; ++i)
+        if (a[i] == val) break;
+    return i;
+}
+
+
+static size_t scalarPopcount(const Byte a[], size_t n)
+{
+    size_t i;
+    size_t count = 0;
+
+    for (i=0; i+8<=n; i+=8)
+        count += popcount64(load64le(a + i));
+    for (; i<n; ++i)
+        count += popcount64(a[i]);
+    return count;
+}
+
+
+static const BitmapKernels scalarKernels = {
+    "scalar", scalarFindByte, scalarPopcount
+};
+
+
+#if BS_X86
+//-----------------------------------------------------------------------------
+// SSE2: 16 bytes a step; counts with SWAR in each byte and sums with PSADBW.
+//-----------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+static size_t sse2FindByte(const Byte a[], size_t n, Byte val)
+{
+    const __m128i v = _mm_set1_epi8((char)val);
+    size_t i;
+
+    for (i=0; i+16<=n; i+=16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        const unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, v));
+
+        if (m != 0)
+            return i + __builtin_ctz(m);
+    }
+    return i + scalarFindByte(a + i, n - i, val);
+}
+
+
+__attribute__((target("sse2")))
+static size_t sse2Popcount(const Byte a[], size_t n)
+{
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0F);
+    __m128i acc = _mm_setzero_si128();
+    uint64_t sum[2];
+    size_t i;
+
+    for (i=0; i+16<=n; i+=16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+
+        x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi64(x, 1), m1));
+        x = _mm_add_epi8(_mm_and_si128(x, m2),
+                         _mm_and_si128(_mm_srli_epi64(x, 2), m2));
+        x = _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi64(x, 4)), m4);
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(x, _mm_setzero_si128()));
+    }
+    _mm_storeu_si128((__m128i*)sum, acc);
+    return sum[0] + sum[1] + scalarPopcount(a + i, n - i);
+}
+
+
+static const BitmapKernels sse2Kernels = {
+    "sse2", sse2FindByte, sse2Popcount
+};
+
+
+//-----------------------------------------------------------------------------
+// AVX2: 32 bytes a step; counts nibbles by a PSHUFB lookup table.
+//-----------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static size_t avx2FindByte(const Byte a[], size_t n, Byte val)
+{
+    const __m256i v = _mm256_set1_epi8((char)val);
+    size_t i;
+
+    for (i=0; i+32<=n; i+=32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        const unsigned m =
+            (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, v));
+
+        if (m != 0)
+            return i + __builtin_ctz(m);
+    }
+    return i + sse2FindByte(a + i, n - i, val);
+}
+
+
+__attribute__((target("avx2")))
+static size_t avx2Popcount(const Byte a[], size_t n)
+{
+    const __m256i lut = _mm256_setr_epi8(0,1,1,2, 1,2,2,3, 1,2,2,3, 2,3,3,4,
+                                         0,1,1,2, 1,2,2,3, 1,2,2,3, 2,3,3,4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i acc = _mm256_setzero_si256();
+    uint64_t sum[4];
+    size_t i;
+
+    for (i=0; i+32<=n; i+=32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i lo = _mm256_and_si256(x, low);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), low);
+        const __m256i c = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo),
+                                          _mm256_shuffle_epi8(lut, hi));
+
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(c, _mm256_setzero_si256()));
+    }
+    _mm256_storeu_si256((__m256i*)sum, acc);
+    return sum[0] + sum[1] + sum[2] + sum[3]
+         + sse2Popcount(a + i, n - i);
+}
+
+
+static const BitmapKernels avx2Kernels = {
+    "avx2", avx2FindByte, avx2Popcount
+};
+
+
+//-----------------------------------------------------------------------------
+// AVX-512BW: 64 bytes a step; compares into a mask register.
+//-----------------------------------------------------------------------------
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t avx512FindByte(const Byte a[], size_t n, Byte val)
+{
+    const __m512i v = _mm512_set1_epi8((char)val);
+    size_t i;
+
+    for (i=0; i+64<=n; i+=64) {
+        const __m512i x = _mm512_loadu_si512((const void*)(a + i));
+        const __mmask64 m = _mm512_cmpeq_epi8_mask(x, v);
+
+        if (m != 0)
+            return i + __builtin_ctzll(m);
+    }
+    return i + avx2FindByte(a + i, n - i, val);
+}
+
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t avx512Popcount(const Byte a[], size_t n)
+{
+    const __m512i lut = _mm512_broadcast_i32x4(
+        _mm_setr_epi8(0,1,1,2, 1,2,2,3, 1,2,2,3, 2,3,3,4));
+    const __m512i low = _mm512_set1_epi8(0x0F);
+    __m512i acc = _mm512_setzero_si512();
+    size_t i;
+
+    for (i=0; i+64<=n; i+=64) {
+        const __m512i x = _mm512_loadu_si512((const void*)(a + i));
+        const __m512i lo = _mm512_and_si512(x, low);
+        const __m512i hi = _mm512_and_si512(_mm512_srli_epi16(x, 4), low);
+        const __m512i c = _mm512_add_epi8(_mm512_shuffle_epi8(lut, lo),
+                                          _mm512_shuffle_epi8(lut, hi));
+
+        acc = _mm512_add_epi64(acc, _mm512_sad_epu8(c, _mm512_setzero_si512()));
+    }
+    return (size_t)_mm512_reduce_add_epi64(acc)
+         + avx2Popcount(a + i, n - i);
+}
+
+
+static const BitmapKernels avx512Kernels = {
+    "avx512bw", avx512FindByte, avx512Popcount
+};
+
+#endif // BS_X86
+
+//-----------------------------------------------------------------------------
+
+/** Lists the kernel sets the CPU can run, from the scalar reference to the
+ *      widest.
+ * @param[out] list the available kernel sets.
+ * @return the number of kernel sets in \a list.
+ */
+size_t BS_listKernels( const BitmapKernels* list[BS_MAX_KERNELS] )
+{
+    size_t n = 0;
+
+    list[n++] = &scalarKernels;
+#if BS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2"))
+        list[n++] = &sse2Kernels;
+    if (__builtin_cpu_supports("avx2"))
+        list[n++] = &avx2Kernels;
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        list[n++] = &avx512Kernels;
+#endif
+    return n;
+}
+
+
+/// The kernel set BS_kernels() returns; written only before main() runs
+static const BitmapKernels* selected = &scalarKernels;
+
+#if BS_X86
+/** Selects the widest kernel set the CPU can run. As a constructor it runs
+ *      once at load time, before any thread can call BS_kernels().
+ */
+__attribute__((constructor))
+static void selectKernels( void )
+{
+    const BitmapKernels* list[BS_MAX_KERNELS];
+
+    selected = list[BS_listKernels(list) - 1];
+}
+#endif
+
+
+/** Returns the widest kernel set the CPU can run, as selected at load time.
+ */
+const BitmapKernels* BS_kernels( void )
+{
+    return selected;
+}
+
+
+/** Returns the scalar reference kernels. */
+const BitmapKernels* BS_scalarKernels( void )
+{
+    return &scalarKernels;
+}
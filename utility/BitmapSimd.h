@@ -0,0 +1,54 @@
+/**
+ * @file BitmapSimd.h
+ *      Interface of SIMD kernels for bulk bitmap scans.
+ *
+ *      The kernels scan raw byte arrays, so they serve any bitmap laid out
+ *      as in the Bitmap module. A set of kernels is chosen once, when the
+ *      program is loaded, from what the CPU reports through CPUID:
+ *      AVX-512BW, AVX2, SSE2, or the scalar reference. BS_kernels() only
+ *      reads the choice, so any thread may call it.
+ *
+ *      Build Bitmap.c with \c BITMAP_SIMD defined to route
+ *      Bitmap_findRisenByte() and the bit counts through the kernels.
+ * @note Host only (GCC or Clang); on other compilers and CPUs only the
+ *      scalar kernels exist.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see BitmapSimd.c
+ * @see BitmapSimd_test.c
+ */
+#ifndef _BITMAP_SIMD_H_
+#define _BITMAP_SIMD_H_
+
+
+#include <stddef.h>
+#include "platform.h"
+
+
+enum {
+    BS_MAX_KERNELS = 4      ///< the number of kernel sets at most
+};
+
+
+/// A set of scan kernels for one instruction set.
+typedef struct {
+    const char* name;   ///< the name of the instruction set
+
+    /// Returns the index of the first byte equal to \a val in a[0..n), or n.
+    size_t (*findByte)(const Byte a[], size_t n, Byte val);
+
+    /// Returns the number of set bits in a[0..n).
+    size_t (*popcount)(const Byte a[], size_t n);
+} BitmapKernels;
+
+
+const BitmapKernels* BS_kernels( void );
+const BitmapKernels* BS_scalarKernels( void );
+size_t BS_listKernels( const BitmapKernels* list[BS_MAX_KERNELS] );
+
+#endif // _BITMAP_SIMD_H_
+
+/** @example BitmapSimd_test.c
+ *      This is an example of how to use the BitmapSimd module.
+ */
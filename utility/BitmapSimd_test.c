@@ -0,0 +1,132 @@
+/**
+ * @file BitmapSimd_test.c
+ *      tests the SIMD kernels against the scalar reference, and measures
+ *      their scan rates.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see BitmapSimd.h
+ * @see BitmapSimd.c
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "BitmapSimd.h"
+#include "Bitmap.h"
+#include "ToyUnit.h"
+
+enum {
+    BUF_SIZE= 1000,         ///< odd-sized, so every kernel has a tail
+    BENCH_SIZE= 16 << 20    ///< bytes scanned to measure the rates
+};
+
+static Byte buf[BUF_SIZE];
+
+
+static double now( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+/** Checks a kernel set against the scalar reference on every offset and
+ *      a spread of lengths of \a buf.
+ * @return the number of mismatches.
+ */
+static size_t compareKernels( const BitmapKernels* k )
+{
+    const BitmapKernels* ref = BS_scalarKernels();
+    size_t errors = 0;
+    size_t off, len;
+
+    for (off=0; off<70; ++off) {
+        for (len=0; off+len<=BUF_SIZE; len += 1 + len/3) {
+            if (k->popcount(buf+off, len) != ref->popcount(buf+off, len))
+                ++errors;
+            if (k->findByte(buf+off, len, 0xFF)
+                    != ref->findByte(buf+off, len, 0xFF))
+                ++errors;
+            if (k->findByte(buf+off, len, 0x5A)
+                    != ref->findByte(buf+off, len, 0x5A))
+                ++errors;
+        }
+    }
+    return errors;
+}
+
+
+/** Prints the scan rates of a kernel set. */
+static void bench( const BitmapKernels* k, const Byte* a )
+{
+    double t0, t1, t2;
+    volatile size_t sink;
+
+    t0= now();
+    sink= k->findByte(a, BENCH_SIZE, 0xFF);
+    t1= now();
+    sink= k->popcount(a, BENCH_SIZE);
+    t2= now();
+    (void)sink;
+    printf("\n%-8s find %6.2f GB/s, count %6.2f GB/s", k->name,
+           BENCH_SIZE / (t1 - t0) / 1e9, BENCH_SIZE / (t2 - t1) / 1e9);
+}
+
+
+int main()
+{
+    const BitmapKernels* list[BS_MAX_KERNELS];
+    size_t nKernels;
+    size_t i;
+    Bitmap b;
+    Byte* big;
+
+    srand(7);
+    for (i=0; i<BUF_SIZE; ++i)
+        buf[i]= (Byte)(rand() & 0x7F);     // no 0xFF yet
+    nKernels= BS_listKernels(list);
+
+    TU_ASSERT("t1-1", nKernels >= 1);
+    TU_ASSERT("t1-2", list[0] == BS_scalarKernels());
+    TU_ASSERT("t1-3", BS_kernels() == list[nKernels-1]);
+
+    for (i=1; i<nKernels; ++i)
+        TU_ASSERT("t2-1", compareKernels(list[i]) == 0);
+
+    buf[3]= buf[500]= buf[BUF_SIZE-1]= 0xFF;
+    buf[77]= buf[200]= 0x5A;
+    for (i=1; i<nKernels; ++i)
+        TU_ASSERT("t2-2", compareKernels(list[i]) == 0);
+
+    // the Bitmap operations built over the kernels
+    Bitmap_init(&b, buf, BUF_SIZE);
+    TU_ASSERT("t3-1", Bitmap_findRisenByte(&b, 0, BUF_SIZE) == 3);
+    TU_ASSERT("t3-2", Bitmap_findRisenByte(&b, 4, BUF_SIZE) == 500);
+    TU_ASSERT("t3-3", Bitmap_findRisenByte(&b, 501, BUF_SIZE-1) == BUF_SIZE-1);
+    TU_ASSERT("t3-4", Bitmap_risenBitCount(&b, 8*BUF_SIZE)
+                      == BS_scalarKernels()->popcount(buf, BUF_SIZE));
+    TU_ASSERT("t3-5", Bitmap_risenBitCountInRange(&b, 13, 8*BUF_SIZE-5)
+                      == BS_scalarKernels()->popcount(buf+2, BUF_SIZE-3)
+                         + Bitmap_risenBitCountInRange(&b, 13, 16)
+                         + Bitmap_risenBitCountInRange(&b, 8*BUF_SIZE-8,
+                                                       8*BUF_SIZE-5));
+
+    // scan rates over a bitmap without a risen byte
+    big= malloc(BENCH_SIZE);
+    TU_ASSERT("t4-1", big != NULL);
+    if (big != NULL) {
+        memset(big, 0x11, BENCH_SIZE);
+        for (i=0; i<nKernels; ++i)
+            bench(list[i], big);
+        free(big);
+    }
+
+    TU_RESULT();
+
+    return 0;
+}
@@ -3,7 +3,7 @@
  *      Unit Test for Bitmap operations.
  * @author Jiang Yu-Kuan <yukuan.jiang@gmail.com>
  * @date 2005/03/13 (initial)
- * @date 2016/01/16 (last revise)
+ * @date 2026/10/17 (last revise)
  * @see Bitmap.h
  * @see Bitmap.c
  */
@@ -14,11 +14,28 @@
 #define ElemsOfArray(x) (sizeof(x) / sizeof(x[0]))
 
 
+/// Counts risen bits of [begin, end) one bit at a time, for reference.
+static size_t slowRisenCount(const Bitmap* b, Index begin, Index end)
+{
+    size_t n = 0;
+
+    for (; begin<end; ++begin)
+        n += Bitmap_getBit(b, begin);
+    return n;
+}
+
+
 int main()
 {
     Bitmap b1, b2;
     Byte a1[BITMAP_NSLOTS(8*3)]= {0x00, 0x00, 0x00};
     Byte a2[BITMAP_NSLOTS(8*3)];
+    Bitmap b3;
+    Byte a3[BITMAP_NSLOTS(8*37)];   // spans words, with a partial last one
+    Bitmap b4, b5;
+    Byte a4[BITMAP_NSLOTS(8*37)];
+    Byte a5[BITMAP_NSLOTS(8*37)];
+    Index i;
 
     Bitmap_init(&b1, a1, ElemsOfArray(a1));
     TU_ASSERT("t0-1", a1[0]==0x00);
@@ -130,6 +147,140 @@ int main()
     TU_ASSERT("t17-2", Bitmap_getPart(&b1, 1)==0xF);
     TU_ASSERT("t17-3", Bitmap_getPart(&b1, 2)==0xF);
 
+    Bitmap_init(&b3, a3, ElemsOfArray(a3));
+    for (i=0; i<ElemsOfArray(a3); ++i)
+        a3[i] = (Byte)(i * 37 + 11);
+    TU_ASSERT("t18-1", Bitmap_risenBitCount(&b3, 8*37)
+                        == slowRisenCount(&b3, 0, 8*37));
+    TU_ASSERT("t18-2", Bitmap_risenBitCountInRange(&b3, 3, 3)==0);
+    TU_ASSERT("t18-3", Bitmap_risenBitCountInRange(&b3, 3, 61)
+                        == slowRisenCount(&b3, 3, 61));
+    TU_ASSERT("t18-4", Bitmap_risenBitCountInRange(&b3, 63, 65)
+                        == slowRisenCount(&b3, 63, 65));
+    TU_ASSERT("t18-5", Bitmap_risenBitCountInRange(&b3, 64, 128)
+                        == slowRisenCount(&b3, 64, 128));
+    TU_ASSERT("t18-6", Bitmap_risenBitCountInRange(&b3, 5, 8*37-3)
+                        == slowRisenCount(&b3, 5, 8*37-3));
+    TU_ASSERT("t18-7", Bitmap_sunkBitCountInRange(&b3, 5, 8*37-3)
+                        == 8*37-8 - slowRisenCount(&b3, 5, 8*37-3));
+    TU_ASSERT("t18-8", Bitmap_risenBitCount(&b3, 0)==0);
+
+    Bitmap_clearAllBits(&b3);
+    Bitmap_setBit(&b3, 8*37-1);
+    TU_ASSERT("t19-1", Bitmap_risenBitCountInRange(&b3, 0, 8*37)==1);
+    TU_ASSERT("t19-2", Bitmap_risenBitCountInRange(&b3, 0, 8*37-1)==0);
+    TU_ASSERT("t19-3", Bitmap_risenBitCountInRange(&b3, 8*37-1, 8*37)==1);
+
+    Bitmap_setBit(&b3, 70);     // {70, 8*37-1} are risen
+    TU_ASSERT("t20-1", Bitmap_findRisenBit(&b3, 0, 8*37)==70);
+    TU_ASSERT("t20-2", Bitmap_findRisenBit(&b3, 71, 8*37)==8*37-1);
+    TU_ASSERT("t20-3", Bitmap_findRisenBit(&b3, 71, 8*37-1)==8*37-1);
+    TU_ASSERT("t20-4", Bitmap_findRisenBit(&b3, 5, 5)==5);
+    TU_ASSERT("t20-5", Bitmap_findLastRisenBit(&b3, 0, 8*37)==8*37-1);
+    TU_ASSERT("t20-6", Bitmap_findLastRisenBit(&b3, 0, 8*37-1)==70);
+    TU_ASSERT("t20-7", Bitmap_findLastRisenBit(&b3, 71, 8*37-1)==8*37-1);
+    TU_ASSERT("t20-8", Bitmap_findLastRisenBit(&b3, 0, 70)==70);
+
+    for (i=0; i<ElemsOfArray(a3); ++i)
+        a3[i] = 0xFF;
+    Bitmap_clrBit(&b3, 3);
+    Bitmap_clrBit(&b3, 200);    // {3, 200} are sunk
+    TU_ASSERT("t21-1", Bitmap_findSunkBit(&b3, 0, 8*37)==3);
+    TU_ASSERT("t21-2", Bitmap_findSunkBit(&b3, 4, 8*37)==200);
+    TU_ASSERT("t21-3", Bitmap_findSunkBit(&b3, 201, 8*37)==8*37);
+    TU_ASSERT("t21-4", Bitmap_findSunkBitRingedly(&b3, 201, 8*37)==3);
+    TU_ASSERT("t21-5", Bitmap_findSunkBitRingedly(&b3, 4, 8*37)==200);
+    TU_ASSERT("t21-6", Bitmap_findLastSunkBit(&b3, 0, 8*37)==200);
+    TU_ASSERT("t21-7", Bitmap_findLastSunkBit(&b3, 4, 200)==200);
+    TU_ASSERT("t21-8", Bitmap_findLastSunkBitRingedly(&b3, 199, 8*37)==3);
+    TU_ASSERT("t21-9", Bitmap_findLastSunkBitRingedly(&b3, 2, 8*37)==200);
+    TU_ASSERT("t21-10", Bitmap_findLastSunkBitRingedly(&b3, 200, 8*37)==200);
+    Bitmap_setBit(&b3, 3);
+    Bitmap_setBit(&b3, 200);
+    TU_ASSERT("t21-11", Bitmap_findSunkBitRingedly(&b3, 9, 8*37)==8*37);
+    TU_ASSERT("t21-12", Bitmap_findLastSunkBitRingedly(&b3, 9, 8*37)==8*37);
+    TU_ASSERT("t21-13", Bitmap_findLastRisenBitRingedly(&b3, 9, 8*37)==9);
+
+    Bitmap_clearAllBits(&b3);
+    Bitmap_setRange(&b3, 3, 5);         // inside one byte
+    TU_ASSERT("t22-1", a3[0]==0x18);
+    Bitmap_setRange(&b3, 13, 13);       // empty
+    TU_ASSERT("t22-2", a3[1]==0x00);
+    Bitmap_setRange(&b3, 13, 250);
+    TU_ASSERT("t22-3", a3[1]==0xE0);
+    TU_ASSERT("t22-4", a3[2]==0xFF && a3[30]==0xFF);
+    TU_ASSERT("t22-5", a3[31]==0x03);
+    TU_ASSERT("t22-6", Bitmap_risenBitCount(&b3, 8*37)==2 + 250-13);
+    TU_ASSERT("t22-7", Bitmap_isRangeSet(&b3, 13, 250));
+    TU_ASSERT("t22-8", !Bitmap_isRangeSet(&b3, 12, 250));
+    TU_ASSERT("t22-9", !Bitmap_isRangeSet(&b3, 13, 251));
+    TU_ASSERT("t22-10", Bitmap_isRangeClear(&b3, 250, 8*37));
+    TU_ASSERT("t22-11", !Bitmap_isRangeClear(&b3, 249, 8*37));
+
+    Bitmap_clrRange(&b3, 14, 249);
+    TU_ASSERT("t23-1", a3[1]==0x20);
+    TU_ASSERT("t23-2", a3[2]==0x00 && a3[30]==0x00);
+    TU_ASSERT("t23-3", a3[31]==0x02);
+    Bitmap_clrRange(&b3, 4, 5);
+    TU_ASSERT("t23-4", a3[0]==0x08);
+    Bitmap_setRange(&b3, 0, 8*37);
+    TU_ASSERT("t23-5", Bitmap_isRangeSet(&b3, 0, 8*37));
+    Bitmap_clrRange(&b3, 0, 8*37);
+    TU_ASSERT("t23-6", Bitmap_isRangeClear(&b3, 0, 8*37));
+
+    Bitmap_init(&b4, a4, ElemsOfArray(a4));
+    Bitmap_init(&b5, a5, ElemsOfArray(a5));
+    Bitmap_clearAllBits(&b4);
+    Bitmap_setRange(&b3, 0, 100);
+    Bitmap_setRange(&b4, 50, 8*37);     // b3 & b4 = [50, 100)
+    TU_ASSERT("t24-1", Bitmap_andCount(&b3, &b4)==50);
+    TU_ASSERT("t24-2", Bitmap_intersects(&b3, &b4));
+    Bitmap_and(&b3, &b4, &b5);
+    TU_ASSERT("t24-3", Bitmap_risenBitCount(&b5, 8*37)==50);
+    TU_ASSERT("t24-4", Bitmap_isRangeSet(&b5, 50, 100));
+    Bitmap_or(&b3, &b4, &b5);
+    TU_ASSERT("t24-5", Bitmap_isRangeSet(&b5, 0, 8*37));
+    Bitmap_xor(&b3, &b4, &b5);
+    TU_ASSERT("t24-6", Bitmap_isRangeClear(&b5, 50, 100));
+    TU_ASSERT("t24-7", Bitmap_risenBitCount(&b5, 8*37)==8*37-50);
+    Bitmap_andNot(&b3, &b4, &b5);
+    TU_ASSERT("t24-8", Bitmap_isRangeSet(&b5, 0, 50));
+    TU_ASSERT("t24-9", Bitmap_risenBitCount(&b5, 8*37)==50);
+
+    Bitmap_andNot(&b4, &b3, &b4);       // in place: b4 = [100, 8*37)
+    TU_ASSERT("t25-1", Bitmap_findRisenBit(&b4, 0, 8*37)==100);
+    TU_ASSERT("t25-2", !Bitmap_intersects(&b3, &b4));
+    TU_ASSERT("t25-3", Bitmap_andCount(&b3, &b4)==0);
+    Bitmap_setBit(&b3, 8*37-1);         // in the tail byte
+    TU_ASSERT("t25-4", Bitmap_intersects(&b3, &b4));
+    TU_ASSERT("t25-5", Bitmap_andCount(&b3, &b4)==1);
+    Bitmap_or(&b3, &b4, &b3);
+    TU_ASSERT("t25-6", Bitmap_isRangeSet(&b3, 0, 8*37));
+
+    Bitmap_clearAllBits(&b3);
+    Bitmap_setPartTotalBits(&b3, 3);
+    TU_ASSERT("t26-1", Bitmap_totalParts(&b3)==98);
+    Bitmap_setPart(&b3, 2, 0x5);        // bits 6..8, across a byte
+    TU_ASSERT("t26-2", a3[0]==0x40 && a3[1]==0x01);
+    TU_ASSERT("t26-3", Bitmap_getPart(&b3, 2)==0x5);
+    Bitmap_setPart(&b3, 2, 0x2);
+    TU_ASSERT("t26-4", a3[0]==0x80 && a3[1]==0x00);
+    TU_ASSERT("t26-5", Bitmap_getPart(&b3, 1)==0x0);
+    TU_ASSERT("t26-6", Bitmap_getPart(&b3, 3)==0x0);
+
+    a3[36] = 0xC0;                      // bits after the last part
+    Bitmap_fillAllParts(&b3, 0x6);
+    for (i=0; i<Bitmap_totalParts(&b3); ++i)
+        if (Bitmap_getPart(&b3, i) != 0x6) break;
+    TU_ASSERT("t27-1", i==98);
+    TU_ASSERT("t27-2", (a3[36] & 0xC0)==0xC0);
+    Bitmap_setPartTotalBits(&b3, 7);
+    Bitmap_fillAllParts(&b3, 0x55);
+    for (i=0; i<Bitmap_totalParts(&b3); ++i)
+        if (Bitmap_getPart(&b3, i) != 0x55) break;
+    TU_ASSERT("t27-3", i==42);
+    TU_ASSERT("t27-4", Bitmap_getBit(&b3, 8*37-1)==1);   // untouched
+
     TU_RESULT();
 
     return 0;
@@ -0,0 +1,230 @@
+/**
+ * @file BroadcastQueue.c
+ *      Implements a broadcast ring, and that uses a circular array with
+ *      free-running positions for the producer and each reader.
+ *
+ *      A lagging reader is caught up lazily when it reads, so a put costs
+ *      O(1) under #BQ_SKIP_SLOWEST and O(readers) under #BQ_BACKPRESSURE.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see BroadcastQueue.h
+ * @see BroadcastQueue_test.c
+ */
+#include <string.h>
+
+#include "BroadcastQueue.h"
+#include "assertions.h"
+
+
+/** Skips the items of reader \a r that the producer has overwritten. */
+static void catchUp( BroadcastQueue* q, int r )
+{
+    size_t lag= q->end - q->cursor[r];
+
+    if (lag > q->buf_size) {
+        q->lost[r] += lag - q->buf_size;
+        q->cursor[r]= q->end - q->buf_size;
+    }
+}
+
+
+/** Initilizes a queue with no reader.
+ * @param[out] q the queue to be initialized.
+ * @param[in] buf the buffer to store items.
+ * @param[in] buf_size the buffer size.
+ * @param[in] policy the policy for the slowest reader.
+ */
+void BQ_init( BroadcastQueue* q, QueueItem* buf, size_t buf_size,
+              BQPolicy policy )
+{
+    int r;
+
+    q->buf= buf;
+    q->buf_size= buf_size;
+    q->policy= policy;
+    q->end= 0;
+    for (r=0; r<BQ_MAX_READERS; ++r)
+        q->active[r]= false;
+}
+
+
+/** Registers a reader. It reads the items put from now on.
+ * @return the reader ID; #BQ_NO_READER if all reader slots are taken.
+ */
+int BQ_addReader( BroadcastQueue* q )
+{
+    int r;
+
+    for (r=0; r<BQ_MAX_READERS; ++r) {
+        if (!q->active[r]) {
+            q->active[r]= true;
+            q->cursor[r]= q->end;
+            q->lost[r]= 0;
+            return r;
+        }
+    }
+    return BQ_NO_READER;
+}
+
+
+/** Unregisters reader \a r; it no longer holds the producer back. */
+void BQ_removeReader( BroadcastQueue* q, int r )
+{
+    ASSERT_OP (r, >=, 0);
+    ASSERT_OP (r, <, BQ_MAX_READERS);
+
+    q->active[r]= false;
+}
+
+
+/** Returns the number of items the producer can put now.
+ * It is the whole buffer under #BQ_SKIP_SLOWEST.
+ */
+size_t BQ_room( const BroadcastQueue* q )
+{
+    size_t maxLag= 0;
+    int r;
+
+    if (q->policy == BQ_SKIP_SLOWEST)
+        return q->buf_size;
+
+    for (r=0; r<BQ_MAX_READERS; ++r) {
+        if (q->active[r] && q->end - q->cursor[r] > maxLag)
+            maxLag= q->end - q->cursor[r];
+    }
+    return q->buf_size - maxLag;
+}
+
+
+/** Puts an item for all readers.
+ * @param[in,out] q the queue to add an item.
+ * @param[in] i the added item.
+ * @retval true if the item is put.
+ * @retval false if the slowest reader is a buffer behind (backpressure).
+ */
+bool BQ_put( BroadcastQueue* q, QueueItem i )
+{
+    if (q->policy == BQ_BACKPRESSURE && BQ_room(q) == 0)
+        return false;
+
+    q->buf[q->end % q->buf_size]= i;
+    ++q->end;
+    return true;
+}
+
+
+/** Puts up to \a n items for all readers.
+ * The items are copied in at most two contiguous runs around the wrap point.
+ * Under #BQ_SKIP_SLOWEST all \a n items are taken, but if \a n exceeds the
+ * buffer size only the last \a buf_size are kept; the readers skip the
+ * others as lost items.
+ * @return the number of items taken from \a items; less than \a n only
+ *      under backpressure.
+ */
+size_t BQ_putN( BroadcastQueue* q, const QueueItem* items, size_t n )
+{
+    size_t room= BQ_room(q);
+    size_t taken= n;
+    size_t at, run;
+
+    if (n > room) {
+        if (q->policy == BQ_BACKPRESSURE) {
+            n= room;
+            taken= room;
+        }
+        else {
+            // Only the last buf_size items can survive.
+            q->end += n - room;
+            items += n - room;
+            n= room;
+        }
+    }
+
+    at= q->end % q->buf_size;
+    run= q->buf_size - at;
+    if (run > n)
+        run= n;
+    memcpy(q->buf + at, items, run * sizeof(QueueItem));
+    memcpy(q->buf, items + run, (n - run) * sizeof(QueueItem));
+    q->end += n;
+    return taken;
+}
+
+
+/** Gets the next item of reader \a r.
+ * @param[in,out] q the queue.
+ * @param[in] r the reader ID.
+ * @param[out] i the gotten item.
+ * @retval true if an item is gotten.
+ * @retval false if the reader has read all items.
+ */
+bool BQ_get( BroadcastQueue* q, int r, QueueItem* i )
+{
+    ASSERT_OP (r, >=, 0);
+    ASSERT_OP (r, <, BQ_MAX_READERS);
+
+    catchUp(q, r);
+    if (q->cursor[r] == q->end)
+        return false;
+    *i= q->buf[q->cursor[r] % q->buf_size];
+    ++q->cursor[r];
+    return true;
+}
+
+
+/** Gets up to \a n next items of reader \a r.
+ * The items are copied out in at most two contiguous runs around the wrap
+ * point.
+ * @return the number of items gotten.
+ */
+size_t BQ_getN( BroadcastQueue* q, int r, QueueItem* items, size_t n )
+{
+    size_t at, run;
+
+    ASSERT_OP (r, >=, 0);
+    ASSERT_OP (r, <, BQ_MAX_READERS);
+
+    catchUp(q, r);
+    if (n > q->end - q->cursor[r])
+        n= q->end - q->cursor[r];
+
+    at= q->cursor[r] % q->buf_size;
+    run= q->buf_size - at;
+    if (run > n)
+        run= n;
+    memcpy(items, q->buf + at, run * sizeof(QueueItem));
+    memcpy(items + run, q->buf, (n - run) * sizeof(QueueItem));
+    q->cursor[r] += n;
+    return n;
+}
+
+
+/** Gets the number of items reader \a r has not read yet. */
+size_t BQ_size( const BroadcastQueue* q, int r )
+{
+    size_t lag;
+
+    ASSERT_OP (r, >=, 0);
+    ASSERT_OP (r, <, BQ_MAX_READERS);
+
+    lag= q->end - q->cursor[r];
+    return (lag > q->buf_size) ? q->buf_size : lag;
+}
+
+
+/** Returns and resets the number of items reader \a r has skipped.
+ * A non-zero result means a gap just before the next item of the reader.
+ */
+size_t BQ_takeLost( BroadcastQueue* q, int r )
+{
+    size_t n;
+
+    ASSERT_OP (r, >=, 0);
+    ASSERT_OP (r, <, BQ_MAX_READERS);
+
+    catchUp(q, r);
+    n= q->lost[r];
+    q->lost[r]= 0;
+    return n;
+}
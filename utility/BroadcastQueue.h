@@ -0,0 +1,67 @@
+/**
+ * @file BroadcastQueue.h
+ *      Interface of a broadcast ring: one producer, many readers.
+ *
+ *      The producer writes each item once, and every registered reader
+ *      reads all of them through its own cursor, so one stream can feed
+ *      several sinks without an N-way copy. When the slowest reader lags a
+ *      whole buffer behind, the producer either stops (#BQ_BACKPRESSURE)
+ *      or goes on and the lagging reader skips the overwritten items
+ *      (#BQ_SKIP_SLOWEST).
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see BroadcastQueue.c
+ * @see BroadcastQueue_test.c
+ */
+#ifndef _BROADCAST_QUEUE_H_
+#define _BROADCAST_QUEUE_H_
+
+
+#include <stddef.h>
+#include "platform.h"
+#include "Queue.h"
+
+
+enum {
+    BQ_MAX_READERS= 4,  ///< the maximum number of readers of a queue
+    BQ_NO_READER= -1    ///< returned if no more reader can be added
+};
+
+/// What the producer does when the slowest reader is a buffer behind.
+typedef enum {
+    BQ_BACKPRESSURE,    ///< the put fails until the reader catches up.
+    BQ_SKIP_SLOWEST     ///< the put succeeds; the reader loses old items.
+} BQPolicy;
+
+typedef struct {
+    QueueItem* buf;     ///< a pointer that indicates the buffer of a queue.
+    size_t buf_size;    ///< buffer size.
+    BQPolicy policy;    ///< the policy for the slowest reader.
+    size_t end;         ///< free-running position of the end (last+1).
+    size_t cursor[BQ_MAX_READERS];  ///< free-running position of readers.
+    size_t lost[BQ_MAX_READERS];    ///< items skipped by each reader.
+    bool active[BQ_MAX_READERS];    ///< whether a reader is registered.
+} BroadcastQueue;
+
+
+void BQ_init( BroadcastQueue* q, QueueItem* buf, size_t buf_size,
+              BQPolicy policy );
+
+int BQ_addReader( BroadcastQueue* );
+void BQ_removeReader( BroadcastQueue*, int r );
+
+bool BQ_put( BroadcastQueue*, QueueItem );
+size_t BQ_putN( BroadcastQueue*, const QueueItem* items, size_t n );
+size_t BQ_room( const BroadcastQueue* );
+
+bool BQ_get( BroadcastQueue*, int r, QueueItem* );
+size_t BQ_getN( BroadcastQueue*, int r, QueueItem* items, size_t n );
+size_t BQ_size( const BroadcastQueue*, int r );
+size_t BQ_takeLost( BroadcastQueue*, int r );
+
+#endif // _BROADCAST_QUEUE_H_
+
+/** @example BroadcastQueue_test.c
+ *      This is an example of how to use the BroadcastQueue module.
+ */
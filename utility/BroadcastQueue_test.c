@@ -0,0 +1,80 @@
+/**
+ * @file BroadcastQueue_test.c
+ *      tests the broadcast ring.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see BroadcastQueue.h
+ * @see BroadcastQueue.c
+ */
+#include <string.h>
+
+#include "BroadcastQueue.h"
+#include "ToyUnit.h"
+
+enum {
+    BUF_SIZE= 4
+};
+
+char buf[BUF_SIZE];
+
+
+int main()
+{
+    BroadcastQueue q;
+    QueueItem i;
+    char items[8];
+    int uart, file, r;
+
+    BQ_init( &q, buf, BUF_SIZE, BQ_BACKPRESSURE );
+    uart= BQ_addReader(&q);
+    file= BQ_addReader(&q);
+    TU_ASSERT("01", uart != BQ_NO_READER && file != BQ_NO_READER);
+    TU_ASSERT("02", uart != file);
+    TU_ASSERT("03", BQ_room(&q) == BUF_SIZE);
+    TU_ASSERT("04", !BQ_get(&q, uart, &i));
+
+    TU_ASSERT("11", BQ_put(&q, 'a'));
+    TU_ASSERT("12", BQ_putN(&q, "bcd", 3) == 3);
+    TU_ASSERT("13", BQ_size(&q, uart) == 4 && BQ_size(&q, file) == 4);
+    TU_ASSERT("14", BQ_room(&q) == 0 && !BQ_put(&q, 'e'));
+
+    // each reader sees every item once
+    TU_ASSERT("21", BQ_get(&q, uart, &i) && i == 'a');
+    TU_ASSERT("22", BQ_getN(&q, uart, items, 8) == 3);
+    TU_ASSERT("23", memcmp(items, "bcd", 3) == 0);
+    TU_ASSERT("24", BQ_room(&q) == 0);             // the file lags behind
+    TU_ASSERT("25", BQ_getN(&q, file, items, 2) == 2);
+    TU_ASSERT("26", memcmp(items, "ab", 2) == 0);
+    TU_ASSERT("27", BQ_putN(&q, "efg", 3) == 2);    // wraps around
+    TU_ASSERT("28", BQ_getN(&q, file, items, 8) == 4);
+    TU_ASSERT("29", memcmp(items, "cdef", 4) == 0);
+    TU_ASSERT("30", BQ_getN(&q, uart, items, 8) == 2);
+    TU_ASSERT("31", memcmp(items, "ef", 2) == 0);
+    TU_ASSERT("32", BQ_takeLost(&q, uart) == 0);
+
+    // a removed reader does not hold the producer back
+    BQ_removeReader(&q, file);
+    TU_ASSERT("41", BQ_putN(&q, "ghij", 4) == 4);
+    r= BQ_addReader(&q);
+    TU_ASSERT("42", r == file && BQ_size(&q, r) == 0);
+
+    // the slowest reader skips overwritten items
+    BQ_init( &q, buf, BUF_SIZE, BQ_SKIP_SLOWEST );
+    uart= BQ_addReader(&q);
+    file= BQ_addReader(&q);
+    TU_ASSERT("51", BQ_putN(&q, "abcd", 4) == 4);
+    TU_ASSERT("52", BQ_getN(&q, uart, items, 4) == 4);
+    TU_ASSERT("53", BQ_put(&q, 'e') && BQ_put(&q, 'f'));
+    TU_ASSERT("54", BQ_size(&q, file) == BUF_SIZE);
+    TU_ASSERT("55", BQ_takeLost(&q, file) == 2);
+    TU_ASSERT("56", BQ_getN(&q, file, items, 8) == 4);
+    TU_ASSERT("57", memcmp(items, "cdef", 4) == 0);
+    TU_ASSERT("58", BQ_putN(&q, "0123456", 7) == 7);   // keeps the last 4
+    TU_ASSERT("59", BQ_takeLost(&q, uart) == 5);
+    TU_ASSERT("60", BQ_getN(&q, uart, items, 8) == 4);
+    TU_ASSERT("61", memcmp(items, "3456", 4) == 0);
+
+    TU_RESULT();
+
+    return 0;
+}
@@ -0,0 +1,303 @@
+/**
+ * @file FileQueue.c
+ *      Implements a crash-persistent queue on a memory-mapped file.
+ *
+ *      File layout: an #FQHeader, padded to the page size of the host that
+ *      created the file, then the data area. The header records where the
+ *      data area starts, so the file opens on a host of any page size.
+ *      The items are copied before the position that publishes them is
+ *      stored. Under #FQ_SYNC_FULL they also reach the disk before it, so
+ *      a crash in between loses the item but never exposes a torn one.
+ *      A queue file is owned by one process, so the positions are plain
+ *      stores.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see FileQueue.h
+ * @see FileQueue_test.c
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FileQueue.h"
+
+
+enum {
+    MAGIC= 0x46514655,  ///< "UFQF" in little-endian
+    VERSION= 2
+};
+
+
+/** Returns the page size of the host. */
+static size_t pageSize( void )
+{
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+
+/** Flushes the bytes [\a off, \a off + \a len) of the mapping with \a flags.
+ */
+static bool syncRange( FileQueue* q, size_t off, size_t len, int flags )
+{
+    const size_t page= pageSize();
+    const size_t begin= off / page * page;
+
+    return msync((char*)q->hdr + begin, off + len - begin, flags) == 0;
+}
+
+
+/** Flushes the data positions [\a from, \a to) and waits for them. */
+static void syncData( FileQueue* q, uint64_t from, uint64_t to )
+{
+    const size_t cap= (size_t)q->hdr->capacity;
+    const size_t dataOff= (char*)q->buf - (char*)q->hdr;
+    size_t at= (size_t)(from % cap);
+    size_t run= (size_t)(to - from);
+
+    if (at + run > cap) {
+        syncRange(q, dataOff, at + run - cap, MS_SYNC);
+        run= cap - at;
+    }
+    syncRange(q, dataOff + at, run, MS_SYNC);
+}
+
+
+/** Flushes after \a to - \a from bytes were put, per policy.
+ * Under #FQ_SYNC_FULL the data must have been flushed by syncData() before
+ * the tail was stored; only the header is left to flush here.
+ */
+static void syncAfter( FileQueue* q, uint64_t from, uint64_t to )
+{
+    switch (q->policy) {
+    case FQ_SYNC_NONE:
+        break;
+
+    case FQ_SYNC_BATCH:
+        q->unsynced += (size_t)(to - from);
+        if (q->unsynced >= q->syncBytes) {
+            msync(q->hdr, q->mapSize, MS_ASYNC);
+            q->unsynced= 0;
+        }
+        break;
+
+    case FQ_SYNC_FULL:
+        syncRange(q, 0, sizeof(FQHeader), MS_SYNC);
+        break;
+    }
+}
+
+
+/** Determines if a header is all zero: the file was sized, but the process
+ *  crashed before the header reached the disk.
+ */
+static bool isBlank( const FQHeader* hdr )
+{
+    static const FQHeader blank;
+
+    return memcmp(hdr, &blank, sizeof(blank)) == 0;
+}
+
+
+/** Opens a queue file, or creates it if it does not exist.
+ * An existing file is recovered as it was last left; its own capacity
+ * wins over \a capacity. A file whose header never reached the disk is
+ * set up afresh, with the capacity its size leaves.
+ * @param[out] q the queue to be opened.
+ * @param[in] path the path of the queue file.
+ * @param[in] capacity the number of items of a new queue; 0 to open an
+ *      existing file only.
+ * @retval true on success.
+ * @retval false if the file cannot be opened or mapped, or is not a
+ *      valid queue file.
+ */
+bool FQ_open( FileQueue* q, const char* path, size_t capacity )
+{
+    const size_t page= pageSize();
+    struct stat st;
+    FQHeader* hdr;
+    bool fresh;
+
+    q->fd= open(path, (capacity > 0) ? O_RDWR | O_CREAT : O_RDWR, 0644);
+    if (q->fd < 0)
+        return false;
+    if (fstat(q->fd, &st) != 0)
+        goto fail;
+
+    fresh= (st.st_size == 0);
+    if (fresh) {
+        if (capacity == 0
+            || ftruncate(q->fd, (off_t)(page + capacity)) != 0)
+            goto fail;
+        q->mapSize= page + capacity;
+    }
+    else {
+        if ((size_t)st.st_size <= sizeof(FQHeader))
+            goto fail;
+        q->mapSize= (size_t)st.st_size;
+    }
+
+    hdr= mmap(NULL, q->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, q->fd, 0);
+    if (hdr == MAP_FAILED)
+        goto fail;
+
+    if (!fresh && isBlank(hdr)) {
+        if (q->mapSize <= page)
+            goto unmap;
+        fresh= true;
+    }
+
+    if (fresh) {
+        hdr->magic= MAGIC;
+        hdr->version= VERSION;
+        hdr->capacity= q->mapSize - page;
+        hdr->dataOffset= page;
+        hdr->head= 0;
+        hdr->tail= 0;
+        // a crash before first use must not leave a file we reject later
+        if (msync(hdr, page, MS_SYNC) != 0)
+            goto unmap;
+    }
+    else if (hdr->magic != MAGIC || hdr->version != VERSION
+             || hdr->dataOffset < sizeof(FQHeader)
+             || hdr->dataOffset >= q->mapSize
+             || hdr->capacity != q->mapSize - hdr->dataOffset
+             || hdr->tail - hdr->head > hdr->capacity)
+        goto unmap;
+
+    q->hdr= hdr;
+    q->buf= (QueueItem*)((char*)hdr + hdr->dataOffset);
+    q->policy= FQ_SYNC_NONE;
+    q->syncBytes= 0;
+    q->unsynced= 0;
+    return true;
+
+unmap:
+    munmap(hdr, q->mapSize);
+fail:
+    close(q->fd);
+    q->fd= -1;
+    return false;
+}
+
+
+/** Flushes and closes a queue file. */
+void FQ_close( FileQueue* q )
+{
+    if (q->policy != FQ_SYNC_NONE)
+        FQ_sync(q);
+    munmap(q->hdr, q->mapSize);
+    close(q->fd);
+    q->hdr= NULL;
+    q->buf= NULL;
+    q->fd= -1;
+}
+
+
+/** Sets how a queue is flushed to disk.
+ * @param[in,out] q the queue.
+ * @param[in] policy the flushing policy.
+ * @param[in] syncBytes bytes between flushes for #FQ_SYNC_BATCH.
+ */
+void FQ_setSyncPolicy( FileQueue* q, FQSyncPolicy policy, size_t syncBytes )
+{
+    q->policy= policy;
+    q->syncBytes= syncBytes;
+    q->unsynced= 0;
+}
+
+
+/** Flushes the whole queue to disk and waits for it.
+ * @retval true on success.
+ */
+bool FQ_sync( FileQueue* q )
+{
+    q->unsynced= 0;
+    return msync(q->hdr, q->mapSize, MS_SYNC) == 0;
+}
+
+
+/** Puts up to \a n items to the end of a queue.
+ * @return the number of items put; less than \a n if the queue gets full.
+ */
+size_t FQ_putN( FileQueue* q, const QueueItem* items, size_t n )
+{
+    const size_t cap= (size_t)q->hdr->capacity;
+    const uint64_t tail= q->hdr->tail;
+    size_t at, run;
+
+    if (n > cap - FQ_size(q))
+        n= cap - FQ_size(q);
+
+    at= (size_t)(tail % cap);
+    run= cap - at;
+    if (run > n)
+        run= n;
+    memcpy(q->buf + at, items, run * sizeof(QueueItem));
+    memcpy(q->buf, items + run, (n - run) * sizeof(QueueItem));
+
+    if (n > 0 && q->policy == FQ_SYNC_FULL)
+        syncData(q, tail, tail + n);
+    q->hdr->tail= tail + n;
+    if (n > 0)
+        syncAfter(q, tail, tail + n);
+    return n;
+}
+
+
+/** Gets up to \a n items from the front of a queue.
+ * @return the number of items gotten; less than \a n if the queue gets empty.
+ */
+size_t FQ_getN( FileQueue* q, QueueItem* items, size_t n )
+{
+    const size_t cap= (size_t)q->hdr->capacity;
+    const uint64_t head= q->hdr->head;
+    size_t at, run;
+
+    if (n > FQ_size(q))
+        n= FQ_size(q);
+
+    at= (size_t)(head % cap);
+    run= cap - at;
+    if (run > n)
+        run= n;
+    memcpy(items, q->buf + at, run * sizeof(QueueItem));
+    memcpy(items + run, q->buf, (n - run) * sizeof(QueueItem));
+
+    q->hdr->head= head + n;
+    if (n > 0 && q->policy == FQ_SYNC_FULL)
+        syncRange(q, 0, sizeof(FQHeader), MS_SYNC);
+    return n;
+}
+
+
+/** Returns the maximum number of items a queue can hold. */
+size_t FQ_capacity( const FileQueue* q )
+{
+    return (size_t)q->hdr->capacity;
+}
+
+
+/** Gets the size of a queue at the moment. */
+size_t FQ_size( const FileQueue* q )
+{
+    return (size_t)(q->hdr->tail - q->hdr->head);
+}
+
+
+/** Determines if a queue is empty. */
+bool FQ_empty( const FileQueue* q )
+{
+    return q->hdr->tail == q->hdr->head;
+}
+
+
+/** Determines if an queue is full */
+bool FQ_full( const FileQueue* q )
+{
+    return FQ_size(q) == q->hdr->capacity;
+}
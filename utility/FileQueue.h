@@ -0,0 +1,78 @@
+/**
+ * @file FileQueue.h
+ *      Interface of a crash-persistent queue backed by a memory-mapped file.
+ *
+ *      The items and the head/tail positions live in a shared mapping of a
+ *      file, so a put or get is a memory copy with no system call, and the
+ *      contents survive a crash or restart of the process. Reopening the
+ *      file recovers the queue in O(1) by checking its header.
+ *      How often the mapping is flushed to disk is set by an #FQSyncPolicy.
+ * @note POSIX hosts only (mmap and msync).
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see FileQueue.c
+ * @see FileQueue_test.c
+ */
+#ifndef _FILE_QUEUE_H_
+#define _FILE_QUEUE_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include "platform.h"
+#include "Queue.h"
+
+
+/// How a file queue trades durability against throughput.
+typedef enum {
+    /** Never msync; the kernel writes back in its own time. The data
+     *  survives a process crash but not a power loss. */
+    FQ_SYNC_NONE,
+    /** Start an asynchronous write-back (MS_ASYNC) every \c syncBytes
+     *  bytes put. */
+    FQ_SYNC_BATCH,
+    /** Wait for the write-back (MS_SYNC) of every put and get. */
+    FQ_SYNC_FULL
+} FQSyncPolicy;
+
+/// The header at the beginning of a queue file.
+typedef struct {
+    uint32_t magic;     ///< identifies a queue file.
+    uint32_t version;   ///< the layout version.
+    uint64_t capacity;  ///< the number of items the data area holds.
+    uint64_t dataOffset;///< where the data area starts in the file.
+    uint64_t head;      ///< free-running position of the first item.
+    uint64_t tail;      ///< free-running position of the end (last+1).
+} FQHeader;
+
+typedef struct {
+    FQHeader* hdr;          ///< the mapped header.
+    QueueItem* buf;         ///< the mapped data area.
+    size_t mapSize;         ///< the size of the whole mapping.
+    int fd;                 ///< the file descriptor of the queue file.
+    FQSyncPolicy policy;    ///< the flushing policy.
+    size_t syncBytes;       ///< bytes between flushes for #FQ_SYNC_BATCH.
+    size_t unsynced;        ///< bytes put since the last flush.
+} FileQueue;
+
+
+bool FQ_open( FileQueue* q, const char* path, size_t capacity );
+void FQ_close( FileQueue* );
+
+void FQ_setSyncPolicy( FileQueue*, FQSyncPolicy policy, size_t syncBytes );
+bool FQ_sync( FileQueue* );
+
+size_t FQ_putN( FileQueue*, const QueueItem* items, size_t n );
+size_t FQ_getN( FileQueue*, QueueItem* items, size_t n );
+
+size_t FQ_capacity( const FileQueue* );
+size_t FQ_size( const FileQueue* );
+bool FQ_empty( const FileQueue* );
+bool FQ_full( const FileQueue* );
+
+#endif // _FILE_QUEUE_H_
+
+/** @example FileQueue_test.c
+ *      This is an example of how to use the FileQueue module.
+ */
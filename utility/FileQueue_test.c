@@ -0,0 +1,118 @@
+/**
+ * @file FileQueue_test.c
+ *      tests the file-backed queue, including recovery after a crash.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see FileQueue.h
+ * @see FileQueue.c
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "FileQueue.h"
+#include "ToyUnit.h"
+
+#define PATH    "FileQueue_test.dat"
+
+enum {
+    CAPACITY= 8
+};
+
+
+int main()
+{
+    FileQueue q;
+    char items[CAPACITY];
+    FILE* f;
+    FQHeader hdr;
+    char page[3 * 1024];    // not the page size of any host
+    pid_t pid;
+    int status;
+
+    remove(PATH);
+    TU_ASSERT("01", FQ_open(&q, PATH, CAPACITY));
+    TU_ASSERT("02", FQ_capacity(&q) == CAPACITY);
+    TU_ASSERT("03", FQ_empty(&q) && !FQ_full(&q));
+
+    TU_ASSERT("11", FQ_putN(&q, "abcdef", 6) == 6);
+    TU_ASSERT("12", FQ_getN(&q, items, 4) == 4);
+    TU_ASSERT("13", memcmp(items, "abcd", 4) == 0);
+    TU_ASSERT("14", FQ_putN(&q, "ghijklmn", 8) == 6);  // wraps around
+    TU_ASSERT("15", FQ_full(&q));
+    FQ_close(&q);
+
+    // reopened as it was left
+    TU_ASSERT("21", FQ_open(&q, PATH, 0));
+    TU_ASSERT("22", FQ_size(&q) == CAPACITY);
+    TU_ASSERT("23", FQ_getN(&q, items, 3) == 3);
+    TU_ASSERT("24", memcmp(items, "efg", 3) == 0);
+    FQ_close(&q);
+
+    // a crashed writer loses nothing it has put
+    pid= fork();
+    if (pid == 0) {
+        FileQueue c;
+
+        if (FQ_open(&c, PATH, 0))
+            FQ_putN(&c, "xyz", 3);
+        _exit(0);   // no FQ_close()
+    }
+    waitpid(pid, &status, 0);
+    TU_ASSERT("31", FQ_open(&q, PATH, 0));
+    FQ_setSyncPolicy(&q, FQ_SYNC_FULL, 0);
+    TU_ASSERT("32", FQ_getN(&q, items, CAPACITY) == CAPACITY);
+    TU_ASSERT("33", memcmp(items, "hijklxyz", CAPACITY) == 0);
+    FQ_setSyncPolicy(&q, FQ_SYNC_BATCH, 2);
+    TU_ASSERT("34", FQ_putN(&q, "abc", 3) == 3);
+    TU_ASSERT("35", FQ_sync(&q));
+    FQ_close(&q);
+
+    // not a queue file
+    f= fopen(PATH, "wb");
+    fputs("garbage", f);
+    fclose(f);
+    TU_ASSERT("41", !FQ_open(&q, PATH, CAPACITY));
+    remove(PATH);
+
+    // no file is left behind by an open of a missing file
+    TU_ASSERT("51", !FQ_open(&q, PATH, 0));
+    TU_ASSERT("52", access(PATH, F_OK) != 0);
+
+    // sized, but crashed before the header reached the disk
+    f= fopen(PATH, "wb");
+    TU_ASSERT("60", ftruncate(fileno(f), sysconf(_SC_PAGESIZE) + CAPACITY) == 0);
+    fclose(f);
+    TU_ASSERT("61", FQ_open(&q, PATH, 0));
+    TU_ASSERT("62", FQ_capacity(&q) == CAPACITY && FQ_empty(&q));
+    TU_ASSERT("63", FQ_putN(&q, "abc", 3) == 3);
+    FQ_close(&q);
+    remove(PATH);
+
+    // created on a host with other pages: the header tells the data offset
+    f= fopen(PATH, "wb");
+    memset(page, 0, sizeof(page));
+    hdr.magic= 0x46514655;
+    hdr.version= 2;
+    hdr.capacity= CAPACITY;
+    hdr.dataOffset= sizeof(page);
+    hdr.head= 0;
+    hdr.tail= 3;
+    memcpy(page, &hdr, sizeof(hdr));
+    fwrite(page, 1, sizeof(page), f);
+    fwrite("xyz", 1, 3, f);
+    fwrite(page + sizeof(hdr), 1, CAPACITY - 3, f);
+    fclose(f);
+    TU_ASSERT("71", FQ_open(&q, PATH, 0));
+    TU_ASSERT("72", FQ_getN(&q, items, CAPACITY) == 3);
+    TU_ASSERT("73", memcmp(items, "xyz", 3) == 0);
+    FQ_close(&q);
+    remove(PATH);
+
+    TU_RESULT();
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file HierBitmap.c
+ *      Implements a hierarchical bitmap that keeps risen and sunk summaries
+ *      of the 64-bit words of a Bitmap.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see HierBitmap.h
+ * @see HierBitmap_test.c
+ */
+#include <string.h>
+#include "assertions.h"
+#include "bitops.h"
+#include "HierBitmap.h"
+
+
+/// Which summary a search follows
+typedef enum {
+    RISEN,
+    SUNK
+} Kind;
+
+
+/// Returns a word mask of bits [\a r, 64) (0 <= r < 64)
+#define HEAD_MASK(r)    (~(uint64_t)0 << (r))
+
+
+/** Returns word[wi] of level \a lv, with a 1 for every bit of \a kind.
+ *      Bits beyond the end of a level read as 0.
+ */
+static uint64_t levelWord(const HierBitmap* h, int lv, size_t wi, Kind kind)
+{
+    if (lv == 0) {
+        const Byte* a = h->b->a;
+        const size_t at = wi * 8;
+        uint64_t w;
+        uint64_t valid = ~(uint64_t)0;
+
+        if (at + 8 <= h->b->n) {
+            w = load64le(a + at);
+        } else {
+            w = loadPartial64le(a + at, h->b->n - at);
+            valid = LOW_MASK64(8 * (h->b->n - at));
+        }
+        return (kind == RISEN) ? w : ~w & valid;
+    }
+    return (kind == RISEN) ? h->risen[lv-1][wi] : h->sunk[lv-1][wi];
+}
+
+
+/** Sets the summary bits of word[wi] of level \a lv, and carries changed
+ *      states upward until a level does not change.
+ */
+static void update(HierBitmap* h, int lv, size_t wi, bool hasRisen,
+                   bool hasSunk)
+{
+    for (; lv<HB_LEVELS; ++lv) {
+        uint64_t* r = &h->risen[lv][wi / 64];
+        uint64_t* s = &h->sunk[lv][wi / 64];
+        const uint64_t bit = (uint64_t)1 << (wi % 64);
+        const uint64_t nr = hasRisen ? (*r | bit) : (*r & ~bit);
+        const uint64_t ns = hasSunk ? (*s | bit) : (*s & ~bit);
+
+        if (nr == *r && ns == *s)
+            return;
+        *r = nr;
+        *s = ns;
+        hasRisen = nr != 0;
+        hasSunk = ns != 0;
+        wi /= 64;
+    }
+}
+
+
+/** Finds the 1st bit of \a kind in [\a begin, \a end).
+ *      It climbs the summaries while the words in its way are empty, then
+ *      descends along the first non-empty one.
+ * @return the index of the found bit; \a end if not found
+ */
+static Index findNext(const HierBitmap* h, Index begin, Index end, Kind kind)
+{
+    size_t pos = begin;     // bit index in level lv
+    int lv = 0;
+    uint64_t w;
+
+    ASSERT_OP (begin, <=, end);
+    ASSERT_OP (end, <=, h->nBits[0]);
+
+    // ascends
+    for (;;) {
+        if (pos >= h->nBits[lv] || (pos << (6*lv)) >= end)
+            return end;
+        w = levelWord(h, lv, pos / 64, kind) & HEAD_MASK(pos % 64);
+        if (w != 0) {
+            pos = pos / 64 * 64 + ctz64(w);
+            break;
+        }
+        pos = pos / 64 + 1;
+        if (lv == HB_LEVELS) {
+            // the top level is scanned linearly
+            for (; pos*64 < h->nBits[lv]; ++pos) {
+                if (((pos*64) << (6*lv)) >= end)
+                    return end;
+                w = levelWord(h, lv, pos, kind);
+                if (w != 0)
+                    break;
+            }
+            if (w == 0)
+                return end;
+            pos = pos * 64 + ctz64(w);
+            break;
+        }
+        ++lv;
+    }
+
+    // descends
+    while (lv > 0) {
+        --lv;
+        w = levelWord(h, lv, pos, kind);
+        ASSERT_OP (w, !=, 0);
+        pos = pos * 64 + ctz64(w);
+    }
+    return (pos < end) ? pos : end;
+}
+
+
+/** Finds a bit of \a kind in [\a begin, \a end), then in [0, \a begin).
+ * @return the index of the found bit; \a end if not found
+ */
+static Index findNextRingedly(const HierBitmap* h, Index begin, Index end,
+                              Kind kind)
+{
+    Index i = findNext(h, begin, end, kind);
+    if (i == end) {
+        i = findNext(h, 0, begin, kind);
+        if (i == begin)
+            return end;
+    }
+    return i;
+}
+
+//-----------------------------------------------------------------------------
+
+/** Initializes a hierarchical bitmap over a bitmap, and builds the
+ *      summaries of its current bits.
+ * @param[out] h the hierarchical bitmap
+ * @param[in] b the summarized bitmap
+ * @param[in] summary the storage of the summaries
+ * @param[in] n the number of words of \a summary; at least
+ *      HIERBITMAP_SUMMARY_WORDS(Bitmap_totalBits(b))
+ */
+void HierBitmap_init(HierBitmap* h, Bitmap* b, uint64_t summary[], size_t n)
+{
+    int lv;
+
+    h->b = b;
+    h->nBits[0] = Bitmap_totalBits(b);
+    ASSERT_OP (n, >=, HIERBITMAP_SUMMARY_WORDS(h->nBits[0]));
+
+    for (lv=0; lv<HB_LEVELS; ++lv) {
+        const size_t nWords = HB_WORDS(h->nBits[lv]);
+
+        h->nBits[lv+1] = nWords;
+        h->risen[lv] = summary;
+        summary += HB_WORDS(nWords);
+        h->sunk[lv] = summary;
+        summary += HB_WORDS(nWords);
+    }
+    HierBitmap_rebuild(h);
+}
+
+
+/** Rebuilds the summaries from the bitmap. Call it after the bitmap was
+ *      changed other than through this module.
+ */
+void HierBitmap_rebuild(HierBitmap* h)
+{
+    int lv;
+    size_t wi;
+
+    for (lv=0; lv<HB_LEVELS; ++lv) {
+        memset(h->risen[lv], 0, HB_WORDS(h->nBits[lv+1]) * sizeof(uint64_t));
+        memset(h->sunk[lv], 0, HB_WORDS(h->nBits[lv+1]) * sizeof(uint64_t));
+    }
+    for (lv=0; lv<HB_LEVELS; ++lv) {
+        for (wi=0; wi<h->nBits[lv+1]; ++wi) {
+            const uint64_t bit = (uint64_t)1 << (wi % 64);
+
+            if (levelWord(h, lv, wi, RISEN) != 0)
+                h->risen[lv][wi / 64] |= bit;
+            if (levelWord(h, lv, wi, SUNK) != 0)
+                h->sunk[lv][wi / 64] |= bit;
+        }
+    }
+}
+
+
+/** Sets bit[i] to 1, and updates the summaries.
+ * @param[in,out] h the hierarchical bitmap
+ * @param[in] i the index of the \em bit to be set
+ */
+void HierBitmap_setBit(HierBitmap* h, Index i)
+{
+    const size_t wi = i / 64;
+
+    Bitmap_setBit(h->b, i);
+    update(h, 0, wi, true, levelWord(h, 0, wi, SUNK) != 0);
+}
+
+
+/** Clears bit[i] to 0, and updates the summaries.
+ * @param[in,out] h the hierarchical bitmap
+ * @param[in] i the index of the cleared \em bit
+ */
+void HierBitmap_clrBit(HierBitmap* h, Index i)
+{
+    const size_t wi = i / 64;
+
+    Bitmap_clrBit(h->b, i);
+    update(h, 0, wi, levelWord(h, 0, wi, RISEN) != 0, true);
+}
+
+
+/** Gets bit[i] */
+Bit HierBitmap_getBit(const HierBitmap* h, Index i)
+{
+    return Bitmap_getBit(h->b, i);
+}
+
+
+/** Sets all bits to zero, and resets the summaries. */
+void HierBitmap_clearAllBits(HierBitmap* h)
+{
+    Bitmap_clearAllBits(h->b);
+    HierBitmap_rebuild(h);
+}
+
+//-----------------------------------------------------------------------------
+
+/** Finds the 1st risen bit (value=1) in the range [\a begin, \a end).
+ * @return the index of the found risen bit; \a end if not found
+ */
+Index HierBitmap_findRisenBit(const HierBitmap* h, Index begin, Index end)
+{
+    return findNext(h, begin, end, RISEN);
+}
+
+
+/** Finds the 1st sunk bit (value=0) in the range [\a begin, \a end).
+ * @return the index of the found sunk bit; \a end if not found
+ */
+Index HierBitmap_findSunkBit(const HierBitmap* h, Index begin, Index end)
+{
+    return findNext(h, begin, end, SUNK);
+}
+
+
+/** Finds a risen bit (value=1) in a ring-shaped bitmap.
+ *      - It first searches the bits in [\a begin, \a end);
+ *      - if not found, re-searches the bits in [\a 0, \a begin).
+ *
+ * @return the index of the found risen bit; \a end if not found
+ */
+Index HierBitmap_findRisenBitRingedly(const HierBitmap* h, Index begin,
+                                     Index end)
+{
+    return findNextRingedly(h, begin, end, RISEN);
+}
+
+
+/** Finds a sunk bit (value=0) in a ring-shaped bitmap.
+ *      - It first searches the bits in [\a begin, \a end);
+ *      - if not found, re-searches the bits in [\a 0, \a begin).
+ *
+ * @return the index of the found sunk bit; \a end if not found
+ */
+Index HierBitmap_findSunkBitRingedly(const HierBitmap* h, Index begin,
+                                    Index end)
+{
+    return findNextRingedly(h, begin, end, SUNK);
+}
@@ -0,0 +1,73 @@
+/**
+ * @file HierBitmap.h
+ *      Interface of a hierarchical bitmap: a Bitmap with summary levels for
+ *      fast first-risen/first-sunk search.
+ *
+ *      Bit \em j of a summary level tells whether 64-bit word \em j of the
+ *      level below holds any risen bit (the \em risen summary), or any sunk
+ *      bit (the \em sunk summary). There are #HB_LEVELS summary levels, so a
+ *      search looks at a few words per level instead of scanning the whole
+ *      bitmap. Each setBit()/clrBit() updates the summaries on its path and
+ *      stops at the first level that does not change.
+ * @note Modify the bits only through this module, or call
+ *      HierBitmap_rebuild() after changing the Bitmap directly.
+ * @note Host only: needs uint64_t.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see HierBitmap.c
+ * @see HierBitmap_test.c
+ */
+#ifndef _HIER_BITMAP_H_
+#define _HIER_BITMAP_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include "platform.h"
+#include "Bitmap.h"
+
+
+enum {
+    HB_LEVELS = 3   ///< the number of summary levels
+};
+
+
+/// Returns the number of 64-bit words holding a given number of bits.
+#define HB_WORDS(nb)    (((nb) + 63) / 64)
+
+/// Returns the number of summary words a bitmap of \a nb bits needs.
+#define HIERBITMAP_SUMMARY_WORDS(nb)                                \
+    (2 * (HB_WORDS(HB_WORDS(nb))                                    \
+        + HB_WORDS(HB_WORDS(HB_WORDS(nb)))                          \
+        + HB_WORDS(HB_WORDS(HB_WORDS(HB_WORDS(nb))))))
+
+
+typedef struct {
+    Bitmap* b;                      ///< the summarized bitmap
+
+    /// bit counts of each level: [0] the bitmap; [1..] the summaries.
+    size_t nBits[HB_LEVELS+1];
+    uint64_t* risen[HB_LEVELS];     ///< risen summary of level 1, 2, ...
+    uint64_t* sunk[HB_LEVELS];      ///< sunk summary of level 1, 2, ...
+} HierBitmap;
+
+
+void HierBitmap_init(HierBitmap*, Bitmap* b, uint64_t summary[], size_t n);
+void HierBitmap_rebuild(HierBitmap*);
+
+void HierBitmap_setBit(HierBitmap*, Index i);
+void HierBitmap_clrBit(HierBitmap*, Index i);
+Bit HierBitmap_getBit(const HierBitmap*, Index i);
+void HierBitmap_clearAllBits(HierBitmap*);
+
+Index HierBitmap_findRisenBit(const HierBitmap*, Index begin, Index end);
+Index HierBitmap_findSunkBit(const HierBitmap*, Index begin, Index end);
+Index HierBitmap_findRisenBitRingedly(const HierBitmap*, Index begin, Index end);
+Index HierBitmap_findSunkBitRingedly(const HierBitmap*, Index begin, Index end);
+
+#endif // _HIER_BITMAP_H_
+
+/** @example HierBitmap_test.c
+ *      This is an example of how to use the HierBitmap module.
+ */
@@ -0,0 +1,137 @@
+/**
+ * @file HierBitmap_test.c
+ *      tests the hierarchical bitmap against plain Bitmap searches.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see HierBitmap.h
+ * @see HierBitmap.c
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "HierBitmap.h"
+#include "ToyUnit.h"
+
+/// Returns the number of elements of an array
+#define ElemsOfArray(x) (sizeof(x) / sizeof(x[0]))
+
+enum {
+    SMALL_BYTES= 13,        ///< not a whole number of 64-bit words
+    BIG_BYTES= 5 << 19,     ///< > 64^4 bits, so the top level has many words
+    BIG_BITS= 8 * BIG_BYTES,
+    N_CHECKS= 300
+};
+
+static Byte small[SMALL_BYTES];
+static uint64_t smallSummary[HIERBITMAP_SUMMARY_WORDS(8*SMALL_BYTES)];
+static Byte big[BIG_BYTES];
+static uint64_t bigSummary[HIERBITMAP_SUMMARY_WORDS(BIG_BITS)];
+
+
+/** Returns a random bit index in [0, n). */
+static Index randomIndex(size_t n)
+{
+    return (((Index)rand() << 16) ^ (Index)rand()) % n;
+}
+
+
+/** Compares searches from random positions with the plain Bitmap ones.
+ * @return the number of mismatches.
+ */
+static size_t compareFinds(const HierBitmap* h, const Bitmap* b)
+{
+    size_t errors = 0;
+    size_t k;
+
+    for (k=0; k<N_CHECKS; ++k) {
+        const Index begin = randomIndex(BIG_BITS);
+        const Index end = begin + randomIndex(BIG_BITS - begin) + 1;
+
+        if (HierBitmap_findRisenBit(h, begin, end)
+                != Bitmap_findRisenBit(b, begin, end))
+            ++errors;
+        if (HierBitmap_findSunkBit(h, begin, end)
+                != Bitmap_findSunkBit(b, begin, end))
+            ++errors;
+        if (HierBitmap_findSunkBitRingedly(h, begin, BIG_BITS)
+                != Bitmap_findSunkBitRingedly(b, begin, BIG_BITS))
+            ++errors;
+    }
+    return errors;
+}
+
+
+int main()
+{
+    Bitmap sb, bb;
+    HierBitmap sh, bh;
+    size_t k, nSunk;
+
+    // a small bitmap with a partial last word
+    Bitmap_init(&sb, small, SMALL_BYTES);
+    HierBitmap_init(&sh, &sb, smallSummary, ElemsOfArray(smallSummary));
+    TU_ASSERT("t1-1", HierBitmap_findRisenBit(&sh, 0, 8*SMALL_BYTES) == 8*SMALL_BYTES);
+    TU_ASSERT("t1-2", HierBitmap_findSunkBit(&sh, 0, 8*SMALL_BYTES) == 0);
+    HierBitmap_setBit(&sh, 70);
+    HierBitmap_setBit(&sh, 100);
+    TU_ASSERT("t1-3", HierBitmap_getBit(&sh, 70));
+    TU_ASSERT("t1-4", HierBitmap_findRisenBit(&sh, 0, 8*SMALL_BYTES) == 70);
+    TU_ASSERT("t1-5", HierBitmap_findRisenBit(&sh, 71, 8*SMALL_BYTES) == 100);
+    TU_ASSERT("t1-6", HierBitmap_findRisenBit(&sh, 71, 100) == 100);
+    TU_ASSERT("t1-7", HierBitmap_findRisenBitRingedly(&sh, 101, 8*SMALL_BYTES) == 70);
+    HierBitmap_clrBit(&sh, 70);
+    TU_ASSERT("t1-8", HierBitmap_findRisenBit(&sh, 0, 8*SMALL_BYTES) == 100);
+
+    for (k=0; k<8*SMALL_BYTES; ++k)
+        HierBitmap_setBit(&sh, k);
+    TU_ASSERT("t2-1", HierBitmap_findSunkBit(&sh, 0, 8*SMALL_BYTES) == 8*SMALL_BYTES);
+    HierBitmap_clrBit(&sh, 8*SMALL_BYTES-1);
+    TU_ASSERT("t2-2", HierBitmap_findSunkBit(&sh, 0, 8*SMALL_BYTES) == 8*SMALL_BYTES-1);
+    TU_ASSERT("t2-3", HierBitmap_findSunkBitRingedly(&sh, 5, 8*SMALL_BYTES) == 8*SMALL_BYTES-1);
+    HierBitmap_setBit(&sh, 8*SMALL_BYTES-1);
+    HierBitmap_clrBit(&sh, 3);
+    TU_ASSERT("t2-4", HierBitmap_findSunkBitRingedly(&sh, 5, 8*SMALL_BYTES) == 3);
+    HierBitmap_clearAllBits(&sh);
+    TU_ASSERT("t2-5", HierBitmap_findRisenBit(&sh, 0, 8*SMALL_BYTES) == 8*SMALL_BYTES);
+
+    // a big, mostly full bitmap
+    memset(big, 0xFF, BIG_BYTES);
+    Bitmap_init(&bb, big, BIG_BYTES);
+    HierBitmap_init(&bh, &bb, bigSummary, ElemsOfArray(bigSummary));
+    TU_ASSERT("t3-1", bh.nBits[HB_LEVELS] > 64);
+    TU_ASSERT("t3-2", HierBitmap_findSunkBit(&bh, 0, BIG_BITS) == BIG_BITS);
+    TU_ASSERT("t3-3", HierBitmap_findRisenBit(&bh, 12345, BIG_BITS) == 12345);
+
+    HierBitmap_clrBit(&bh, BIG_BITS-1);
+    TU_ASSERT("t4-1", HierBitmap_findSunkBit(&bh, 0, BIG_BITS) == BIG_BITS-1);
+    TU_ASSERT("t4-2", HierBitmap_findSunkBit(&bh, 0, BIG_BITS-1) == BIG_BITS-1);
+    TU_ASSERT("t4-3", HierBitmap_findSunkBitRingedly(&bh, BIG_BITS-1, BIG_BITS) == BIG_BITS-1);
+    HierBitmap_clrBit(&bh, 9);
+    TU_ASSERT("t4-4", HierBitmap_findSunkBitRingedly(&bh, 10, BIG_BITS) == BIG_BITS-1);
+    HierBitmap_setBit(&bh, BIG_BITS-1);
+    TU_ASSERT("t4-5", HierBitmap_findSunkBitRingedly(&bh, 10, BIG_BITS) == 9);
+    HierBitmap_setBit(&bh, 9);
+
+    srand(11);
+    for (k=0; k<2000; ++k)
+        HierBitmap_clrBit(&bh, randomIndex(BIG_BITS));
+    for (k=0; k<1000; ++k)
+        HierBitmap_setBit(&bh, randomIndex(BIG_BITS));
+    TU_ASSERT("t5-1", compareFinds(&bh, &bb) == 0);
+
+    // walks over all sunk bits and fills them, as an allocator would
+    nSunk = Bitmap_sunkBitCount(&bb, BIG_BITS);
+    for (k=0; HierBitmap_findSunkBit(&bh, 0, BIG_BITS) != BIG_BITS; ++k)
+        HierBitmap_setBit(&bh, HierBitmap_findSunkBit(&bh, 0, BIG_BITS));
+    TU_ASSERT("t5-2", k == nSunk);
+    TU_ASSERT("t5-3", Bitmap_risenBitCount(&bb, BIG_BITS) == BIG_BITS);
+
+    memset(big, 0, BIG_BYTES / 2);
+    HierBitmap_rebuild(&bh);
+    TU_ASSERT("t6-1", HierBitmap_findRisenBit(&bh, 0, BIG_BITS) == BIG_BITS/2);
+    TU_ASSERT("t6-2", compareFinds(&bh, &bb) == 0);
+
+    TU_RESULT();
+
+    return 0;
+}
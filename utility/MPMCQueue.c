@@ -0,0 +1,172 @@
+/**
+ * @file MPMCQueue.c
+ *      Implements a bounded multi-producer/multi-consumer queue, and that
+ *      uses a circular array of slots with per-slot sequence numbers.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see MPMCQueue.h
+ * @see MPMCQueue_test.c
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <sched.h>
+
+#include "MPMCQueue.h"
+#include "assertions.h"
+
+
+enum {
+    SPINS_BEFORE_YIELD= 64  ///< busy retries of a blocking call per yield
+};
+
+
+/** Initilizes a queue.
+ * @param[out] q the queue to be initialized.
+ * @param[in] slots the slot array.
+ * @param[in] nslots the number of slots; a power of two, at least 2.
+ */
+void MQ_init( MPMCQueue* q, MQSlot* slots, size_t nslots )
+{
+    size_t i;
+
+    ASSERT_OP (nslots, >=, 2);
+    ASSERT_OP ((nslots & (nslots-1)), ==, 0);
+
+    for (i=0; i<nslots; ++i)
+        atomic_init(&slots[i].seq, i);
+    q->slots= slots;
+    q->mask= nslots - 1;
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->head, 0);
+}
+
+
+/** Tries to put an item to the end of a queue.
+ * @param[in,out] q the queue to add an item.
+ * @param[in] i the added item.
+ * @retval true if the item is put.
+ * @retval false if the queue is full.
+ */
+bool MQ_tryPut( MPMCQueue* q, MQItem i )
+{
+    size_t pos= atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    for (;;) {
+        MQSlot* s= &q->slots[pos & q->mask];
+        size_t seq= atomic_load_explicit(&s->seq, memory_order_acquire);
+        ptrdiff_t diff= (ptrdiff_t)(seq - pos);
+
+        if (diff == 0) {
+            // The slot is free in this lap; claim it.
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos+1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                s->item= i;
+                atomic_store_explicit(&s->seq, pos+1, memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) {
+            // The slot still holds an item of the previous lap.
+            return false;
+        }
+        else {
+            // Another producer has taken this position.
+            pos= atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+}
+
+
+/** Tries to get the first item of a queue.
+ * @param[in,out] q the queue to get an item.
+ * @param[out] i the gotten item.
+ * @retval true if an item is gotten.
+ * @retval false if the queue is empty.
+ */
+bool MQ_tryGet( MPMCQueue* q, MQItem* i )
+{
+    size_t pos= atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    for (;;) {
+        MQSlot* s= &q->slots[pos & q->mask];
+        size_t seq= atomic_load_explicit(&s->seq, memory_order_acquire);
+        ptrdiff_t diff= (ptrdiff_t)(seq - (pos+1));
+
+        if (diff == 0) {
+            // The slot is filled in this lap; claim it.
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos+1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                *i= s->item;
+                atomic_store_explicit(&s->seq, pos + q->mask + 1,
+                                      memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) {
+            // The slot has not been filled yet.
+            return false;
+        }
+        else {
+            // Another consumer has taken this position.
+            pos= atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+    }
+}
+
+
+/** Puts an item to the end of a queue; waits while the queue is full.
+ * It spins for a while and then yields the CPU between retries.
+ * @param[in,out] q the queue to add an item.
+ * @param[in] i the added item.
+ */
+void MQ_put( MPMCQueue* q, MQItem i )
+{
+    unsigned spins= 0;
+
+    while (!MQ_tryPut(q, i)) {
+        if (++spins >= SPINS_BEFORE_YIELD) {
+            spins= 0;
+            sched_yield();
+        }
+    }
+}
+
+
+/** Gets the first item of a queue; waits while the queue is empty.
+ * It spins for a while and then yields the CPU between retries.
+ * @param[in,out] q the queue to get an item.
+ * @return the gotten item
+ */
+MQItem MQ_get( MPMCQueue* q )
+{
+    unsigned spins= 0;
+    MQItem i;
+
+    while (!MQ_tryGet(q, &i)) {
+        if (++spins >= SPINS_BEFORE_YIELD) {
+            spins= 0;
+            sched_yield();
+        }
+    }
+    return i;
+}
+
+
+/** Returns the maximum number of items a queue can hold. */
+size_t MQ_capacity( const MPMCQueue* q )
+{
+    return q->mask + 1;
+}
+
+
+/** Gets the size of a queue at the moment.
+ * The result is only a snapshot while other threads are running.
+ */
+size_t MQ_size( const MPMCQueue* q )
+{
+    size_t head= atomic_load_explicit(&q->head, memory_order_acquire);
+    size_t tail= atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    return (tail > head) ? tail - head : 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file MPMCQueue.h
+ *      Interface of a bounded multi-producer/multi-consumer queue.
+ *
+ *      Each slot carries a sequence number that tells whether it is ready
+ *      to be written or read in the current lap, so producers and consumers
+ *      only contend on their own position counter with a compare-and-swap,
+ *      and never take a global lock.
+ * @note Host only; needs C11 atomics.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see MPMCQueue.c
+ * @see MPMCQueue_test.c
+ * @see MPMCQueue_bench.c
+ */
+#ifndef _MPMC_QUEUE_H_
+#define _MPMC_QUEUE_H_
+
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "platform.h"
+
+
+#ifndef MQ_CACHE_LINE_SIZE
+    #define MQ_CACHE_LINE_SIZE  64  ///< cache line size of the host CPU
+#endif
+
+typedef void* MQItem;   ///< the item type in a MPMC queue
+
+/// A slot of a MPMC queue.
+typedef struct {
+    atomic_size_t seq;  ///< the position this slot is ready for.
+    MQItem item;        ///< the stored item.
+} MQSlot;
+
+typedef struct {
+    MQSlot* slots;      ///< the slot array of a queue.
+    size_t mask;        ///< the number of slots - 1.
+
+    /// position of the next put; shared by the producers.
+    _Alignas(MQ_CACHE_LINE_SIZE) atomic_size_t tail;
+
+    /// position of the next get; shared by the consumers.
+    _Alignas(MQ_CACHE_LINE_SIZE) atomic_size_t head;
+} MPMCQueue;
+
+
+void MQ_init( MPMCQueue* q, MQSlot* slots, size_t nslots );
+
+bool MQ_tryPut( MPMCQueue*, MQItem );
+bool MQ_tryGet( MPMCQueue*, MQItem* );
+
+void MQ_put( MPMCQueue*, MQItem );
+MQItem MQ_get( MPMCQueue* );
+
+size_t MQ_capacity( const MPMCQueue* );
+size_t MQ_size( const MPMCQueue* );
+
+#endif // _MPMC_QUEUE_H_
+
+/** @example MPMCQueue_test.c
+ *      This is an example of how to use the MPMCQueue module.
+ */
@@ -0,0 +1,109 @@
+/**
+ * @file MPMCQueue_bench.c
+ *      Measures the MPMC queue under contention.
+ *
+ *      Sweeps 1..N producers against 1..N consumers and reports the
+ *      throughput in operations (put + get pairs) per second.
+ *      Usage: MPMCQueue_bench [N [items]]
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see MPMCQueue.h
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "MPMCQueue.h"
+
+enum {
+    NSLOTS= 1024,
+    MAX_THREADS= 64
+};
+
+static MQSlot slots[NSLOTS];
+static MPMCQueue queue;
+
+
+/** Puts the number of items given by \a arg. */
+static void* producer( void* arg )
+{
+    size_t n= *(const size_t*)arg;
+
+    while (n--)
+        MQ_put(&queue, &queue);
+    return NULL;
+}
+
+
+/** Gets the number of items given by \a arg. */
+static void* consumer( void* arg )
+{
+    size_t n= *(const size_t*)arg;
+
+    while (n--)
+        (void)MQ_get(&queue);
+    return NULL;
+}
+
+
+static double now( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+/** Runs \a np producers and \a nc consumers passing about \a items items.
+ * @return operations per second
+ */
+static double run( int np, int nc, size_t items )
+{
+    pthread_t tp[MAX_THREADS], tc[MAX_THREADS];
+    size_t perProducer= items / np / nc * nc;   // divisible by both
+    size_t perConsumer= perProducer * np / nc;
+    double t0, t1;
+    int t;
+
+    MQ_init(&queue, slots, NSLOTS);
+    t0= now();
+    for (t=0; t<nc; ++t)
+        pthread_create(&tc[t], NULL, consumer, &perConsumer);
+    for (t=0; t<np; ++t)
+        pthread_create(&tp[t], NULL, producer, &perProducer);
+    for (t=0; t<np; ++t)
+        pthread_join(tp[t], NULL);
+    for (t=0; t<nc; ++t)
+        pthread_join(tc[t], NULL);
+    t1= now();
+
+    return perProducer * np / (t1 - t0);
+}
+
+
+int main( int argc, char* argv[] )
+{
+    int n= (argc > 1) ? atoi(argv[1]) : 4;
+    size_t items= (argc > 2) ? (size_t)atol(argv[2]) : 1000000;
+    int np, nc;
+
+    if (n < 1 || n > MAX_THREADS)
+        n= 4;
+
+    printf("ops/sec (rows: producers, columns: consumers)\n");
+    printf("P\\C");
+    for (nc=1; nc<=n; ++nc)
+        printf(" %12d", nc);
+    printf("\n");
+    for (np=1; np<=n; ++np) {
+        printf("%3d", np);
+        for (nc=1; nc<=n; ++nc)
+            printf(" %12.0f", run(np, nc, items));
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file MPMCQueue_test.c
+ *      tests the MPMC queue.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see MPMCQueue.h
+ * @see MPMCQueue.c
+ */
+#include <pthread.h>
+#include <stdint.h>
+
+#include "MPMCQueue.h"
+#include "ToyUnit.h"
+
+enum {
+    NSLOTS= 4,
+    MT_NSLOTS= 256,
+    MT_THREADS= 3,      ///< producers, and also consumers
+    MT_ITEMS= 100000    ///< items per producer
+};
+
+static MQSlot slots[NSLOTS];
+static MQSlot mtSlots[MT_NSLOTS];
+
+static MPMCQueue mtQueue;
+static atomic_ulong mtSum;
+
+
+/** Puts the numbers 1..MT_ITEMS. */
+static void* producer( void* arg )
+{
+    unsigned long n;
+
+    (void)arg;
+    for (n=1; n<=MT_ITEMS; ++n)
+        MQ_put(&mtQueue, (MQItem)n);
+    return NULL;
+}
+
+
+/** Gets MT_ITEMS numbers and adds them up. */
+static void* consumer( void* arg )
+{
+    unsigned long n, sum= 0;
+
+    (void)arg;
+    for (n=0; n<MT_ITEMS; ++n) {
+        MQItem i= MQ_get(&mtQueue);
+        sum += (unsigned long)i;
+    }
+    atomic_fetch_add(&mtSum, sum);
+    return NULL;
+}
+
+
+int main()
+{
+    MPMCQueue q;
+    MQItem i;
+    int a, b, c, d, e;
+    pthread_t tp[MT_THREADS], tc[MT_THREADS];
+    int t;
+
+    MQ_init( &q, slots, NSLOTS );
+    TU_ASSERT("03", MQ_size(&q) == 0);
+    TU_ASSERT("04", MQ_capacity(&q) == NSLOTS);
+    TU_ASSERT("05", !MQ_tryGet(&q, &i));
+
+    TU_ASSERT("11", MQ_tryPut(&q, &a));
+    TU_ASSERT("12", MQ_tryPut(&q, &b));
+    TU_ASSERT("13", MQ_tryPut(&q, &c));
+    TU_ASSERT("14", MQ_tryPut(&q, &d));
+    TU_ASSERT("15", MQ_size(&q) == 4);
+    TU_ASSERT("16", !MQ_tryPut(&q, &e));
+
+    TU_ASSERT("21", MQ_tryGet(&q, &i) && i == &a);
+    TU_ASSERT("22", MQ_tryPut(&q, &e));    // next lap
+    TU_ASSERT("23", MQ_get(&q) == &b);
+    TU_ASSERT("24", MQ_get(&q) == &c);
+    TU_ASSERT("25", MQ_get(&q) == &d);
+    TU_ASSERT("26", MQ_get(&q) == &e);
+    TU_ASSERT("27", MQ_size(&q) == 0);
+    TU_ASSERT("28", !MQ_tryGet(&q, &i));
+
+    // every item put by any producer is gotten exactly once
+    MQ_init( &mtQueue, mtSlots, MT_NSLOTS );
+    for (t=0; t<MT_THREADS; ++t) {
+        pthread_create(&tc[t], NULL, consumer, NULL);
+        pthread_create(&tp[t], NULL, producer, NULL);
+    }
+    for (t=0; t<MT_THREADS; ++t) {
+        pthread_join(tp[t], NULL);
+        pthread_join(tc[t], NULL);
+    }
+    TU_ASSERT("31", atomic_load(&mtSum)
+                    == MT_THREADS * (MT_ITEMS * (MT_ITEMS+1UL) / 2));
+    TU_ASSERT("32", MQ_size(&mtQueue) == 0);
+
+    TU_RESULT();
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file MirrorQueue.c
+ *      Implements a mirrored ring buffer with memfd_create and mmap.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see MirrorQueue.h
+ * @see MirrorQueue_test.c
+ */
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "MirrorQueue.h"
+#include "assertions.h"
+
+
+/** Initilizes a queue, and maps its buffer twice back to back.
+ * @param[out] q the queue to be initialized.
+ * @param[in] min_size the minimum buffer size; rounded up to whole pages.
+ * @retval true on success.
+ * @retval false if the buffer cannot be created or mapped.
+ */
+bool MRQ_init( MirrorQueue* q, size_t min_size )
+{
+    const size_t page= (size_t)sysconf(_SC_PAGESIZE);
+    const size_t size= (min_size + page - 1) / page * page;
+    char* base;
+    int fd;
+
+    q->buf= NULL;
+    q->buf_size= 0;
+    q->first= 0;
+    q->count= 0;
+    if (size == 0)
+        return false;
+
+    fd= memfd_create("MirrorQueue", MFD_CLOEXEC);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return false;
+    }
+
+    // Reserves the address space for both mappings, then maps over it.
+    base= mmap(NULL, 2*size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+             fd, 0) == MAP_FAILED
+        || mmap(base + size, size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(base, 2*size);
+        close(fd);
+        return false;
+    }
+    close(fd);  // the mappings keep the memory
+
+    q->buf= base;
+    q->buf_size= size;
+    return true;
+}
+
+
+/** Unmaps the buffer of a queue. */
+void MRQ_destroy( MirrorQueue* q )
+{
+    if (q->buf != NULL)
+        munmap(q->buf, 2 * q->buf_size);
+    q->buf= NULL;
+    q->buf_size= 0;
+    q->first= 0;
+    q->count= 0;
+}
+
+
+/** Clear the queue */
+void MRQ_clear( MirrorQueue* q )
+{
+    q->first= 0;
+    q->count= 0;
+}
+
+
+/** Returns the readable items of a queue as one contiguous region.
+ * @param[in] q the queue.
+ * @param[out] n the number of readable items.
+ * @return the pointer to the first item.
+ * @see MRQ_consume()
+ */
+QueueItem* MRQ_readPtr( const MirrorQueue* q, size_t* n )
+{
+    *n= q->count;
+    return q->buf + q->first;
+}
+
+
+/** Removes \a n items from the front of a queue.
+ * @param[in,out] q the queue.
+ * @param[in] n the number of removed items; it cannot exceed the size.
+ */
+void MRQ_consume( MirrorQueue* q, size_t n )
+{
+    ASSERT_OP (n, <=, q->count);
+
+    q->count -= n;
+    q->first += n;
+    if (q->first >= q->buf_size)
+        q->first -= q->buf_size;
+}
+
+
+/** Returns the free space of a queue as one contiguous region.
+ * @param[in] q the queue.
+ * @param[out] n the number of free items.
+ * @return the pointer to the end of the queue.
+ * @see MRQ_commit()
+ */
+QueueItem* MRQ_writePtr( const MirrorQueue* q, size_t* n )
+{
+    size_t end= q->first + q->count;
+
+    if (end >= q->buf_size)
+        end -= q->buf_size;
+    *n= q->buf_size - q->count;
+    return q->buf + end;
+}
+
+
+/** Appends \a n items, written in place after MRQ_writePtr(), to a queue.
+ * @param[in,out] q the queue.
+ * @param[in] n the number of added items; it cannot exceed the free space.
+ */
+void MRQ_commit( MirrorQueue* q, size_t n )
+{
+    ASSERT_OP (n, <=, q->buf_size - q->count);
+
+    q->count += n;
+}
+
+
+/** Puts up to \a n items to the end of a queue with one copy.
+ * @return the number of items put; less than \a n if the queue gets full.
+ */
+size_t MRQ_putN( MirrorQueue* q, const QueueItem* items, size_t n )
+{
+    size_t room;
+    QueueItem* p= MRQ_writePtr(q, &room);
+
+    if (n > room)
+        n= room;
+    memcpy(p, items, n * sizeof(QueueItem));
+    MRQ_commit(q, n);
+    return n;
+}
+
+
+/** Gets up to \a n items from the front of a queue with one copy.
+ * @return the number of items gotten; less than \a n if the queue gets empty.
+ */
+size_t MRQ_getN( MirrorQueue* q, QueueItem* items, size_t n )
+{
+    size_t avail;
+    const QueueItem* p= MRQ_readPtr(q, &avail);
+
+    if (n > avail)
+        n= avail;
+    memcpy(items, p, n * sizeof(QueueItem));
+    MRQ_consume(q, n);
+    return n;
+}
+
+
+/** Returns the maximum number of items a queue can hold. */
+size_t MRQ_capacity( const MirrorQueue* q )
+{
+    return q->buf_size;
+}
+
+
+/** Gets the size of a queue at the moment. */
+size_t MRQ_size( const MirrorQueue* q )
+{
+    return q->count;
+}
+
+
+/** Determines if a queue is empty. */
+bool MRQ_empty( const MirrorQueue* q )
+{
+    return q->count == 0;
+}
+
+
+/** Determines if an queue is full */
+bool MRQ_full( const MirrorQueue* q )
+{
+    return q->count == q->buf_size;
+}
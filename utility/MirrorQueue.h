@@ -0,0 +1,55 @@
+/**
+ * @file MirrorQueue.h
+ *      Interface of a mirrored (double-mapped) ring buffer.
+ *
+ *      The same pages are mapped twice back to back, so the item at
+ *      <tt>buf[i + buf_size]</tt> is the item at <tt>buf[i]</tt>. Any readable
+ *      or writable region is therefore one contiguous pointer, and parsers
+ *      or write(2) can run over it with no wrap logic.
+ * @note Linux only (memfd_create and mmap).
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see MirrorQueue.c
+ * @see MirrorQueue_test.c
+ */
+#ifndef _MIRROR_QUEUE_H_
+#define _MIRROR_QUEUE_H_
+
+
+#include <stddef.h>
+#include "platform.h"
+#include "Queue.h"
+
+
+typedef struct {
+    QueueItem* buf;     ///< the first of the two mappings of the buffer.
+    size_t buf_size;    ///< buffer size; a multiple of the page size.
+    size_t first;       ///< index of the first (front) item of a queue.
+    size_t count;       ///< the number of items in a queue.
+} MirrorQueue;
+
+
+bool MRQ_init( MirrorQueue* q, size_t min_size );
+void MRQ_destroy( MirrorQueue* );
+void MRQ_clear( MirrorQueue* );
+
+QueueItem* MRQ_readPtr( const MirrorQueue*, size_t* n );
+void MRQ_consume( MirrorQueue*, size_t n );
+
+QueueItem* MRQ_writePtr( const MirrorQueue*, size_t* n );
+void MRQ_commit( MirrorQueue*, size_t n );
+
+size_t MRQ_putN( MirrorQueue*, const QueueItem* items, size_t n );
+size_t MRQ_getN( MirrorQueue*, QueueItem* items, size_t n );
+
+size_t MRQ_capacity( const MirrorQueue* );
+size_t MRQ_size( const MirrorQueue* );
+bool MRQ_empty( const MirrorQueue* );
+bool MRQ_full( const MirrorQueue* );
+
+#endif // _MIRROR_QUEUE_H_
+
+/** @example MirrorQueue_test.c
+ *      This is an example of how to use the MirrorQueue module.
+ */
@@ -0,0 +1,66 @@
+/**
+ * @file MirrorQueue_test.c
+ *      tests the mirrored ring buffer.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see MirrorQueue.h
+ * @see MirrorQueue.c
+ */
+#include <string.h>
+
+#include "MirrorQueue.h"
+#include "ToyUnit.h"
+
+enum {
+    BIG_SIZE= 4 << 20   ///< a multi-megabyte buffer
+};
+
+
+int main()
+{
+    MirrorQueue q;
+    QueueItem* p;
+    char items[8];
+    size_t n, size;
+
+    TU_ASSERT("01", MRQ_init(&q, 1));
+    size= MRQ_capacity(&q);
+    TU_ASSERT("02", size > 0);
+    TU_ASSERT("03", MRQ_empty(&q));
+    TU_ASSERT("04", !MRQ_full(&q));
+
+    // the second mapping mirrors the first
+    q.buf[0]= 'm';
+    TU_ASSERT("11", q.buf[size] == 'm');
+    q.buf[2*size-1]= 'n';
+    TU_ASSERT("12", q.buf[size-1] == 'n');
+
+    // fill up to 3 items before the end, then write across the end
+    p= MRQ_writePtr(&q, &n);
+    TU_ASSERT("21", p == q.buf && n == size);
+    MRQ_commit(&q, size-3);
+    MRQ_consume(&q, size-3);
+    TU_ASSERT("22", MRQ_putN(&q, "abcdef", 6) == 6);
+    p= MRQ_readPtr(&q, &n);
+    TU_ASSERT("23", n == 6 && memcmp(p, "abcdef", 6) == 0);
+    TU_ASSERT("24", q.buf[0] == 'd');
+    TU_ASSERT("25", MRQ_getN(&q, items, 8) == 6);
+    TU_ASSERT("26", memcmp(items, "abcdef", 6) == 0);
+    TU_ASSERT("27", MRQ_empty(&q));
+
+    p= MRQ_writePtr(&q, &n);
+    MRQ_commit(&q, n);
+    TU_ASSERT("31", MRQ_full(&q) && MRQ_putN(&q, "x", 1) == 0);
+    MRQ_clear(&q);
+    TU_ASSERT("32", MRQ_empty(&q));
+    MRQ_destroy(&q);
+    TU_ASSERT("33", q.buf == NULL);
+
+    TU_ASSERT("41", MRQ_init(&q, BIG_SIZE));
+    TU_ASSERT("42", MRQ_capacity(&q) >= BIG_SIZE);
+    MRQ_destroy(&q);
+
+    TU_RESULT();
+
+    return 0;
+}
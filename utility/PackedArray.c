@@ -0,0 +1,134 @@
+/**
+ * @file PackedArray.c
+ *      Implements an array of unsigned integers packed at any bit width,
+ *      with shift-and-mask word access.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see PackedArray.h
+ * @see PackedArray_test.c
+ */
+#include <string.h>
+#include "assertions.h"
+#include "bitops.h"
+#include "PackedArray.h"
+
+
+/** Reads element[i] without a bounds check. */
+static uint64_t getAt(const PackedArray* pa, size_t i)
+{
+    const size_t pos = i * pa->width;
+    const size_t wi = pos / 64;
+    const unsigned shift = pos % 64;
+    uint64_t val = pa->w[wi] >> shift;
+
+    if (shift + pa->width > 64)
+        val |= pa->w[wi+1] << (64 - shift);
+    return val & pa->mask;
+}
+
+//-----------------------------------------------------------------------------
+
+/** Initializes a packed array. The elements are not cleared.
+ * @param[out] pa the packed array
+ * @param[in] w the storage; at least PACKEDARRAY_WORDS(n, width) words
+ * @param[in] n the number of elements
+ * @param[in] width the bits of an element; 1 to 64
+ */
+void PackedArray_init(PackedArray* pa, uint64_t w[], size_t n, unsigned width)
+{
+    ASSERT_OP (width, >=, 1);
+    ASSERT_OP (width, <=, 64);
+
+    pa->w = w;
+    pa->n = n;
+    pa->width = width;
+    pa->mask = LOW_MASK64(width);
+}
+
+
+/** Sets element[i] to a value.
+ * @param[in,out] pa the packed array
+ * @param[in] i the index of the element
+ * @param[in] val the value; at most 2^width-1
+ */
+void PackedArray_set(PackedArray* pa, size_t i, uint64_t val)
+{
+    const size_t pos = i * pa->width;
+    const size_t wi = pos / 64;
+    const unsigned shift = pos % 64;
+
+    ASSERT_OP (i, <, pa->n);
+    ASSERT_OP (val, <=, pa->mask);
+
+    pa->w[wi] = (pa->w[wi] & ~(pa->mask << shift)) | (val << shift);
+    if (shift + pa->width > 64) {
+        const unsigned spill = shift + pa->width - 64;
+
+        pa->w[wi+1] = (pa->w[wi+1] & ~LOW_MASK64(spill))
+                    | (val >> (pa->width - spill));
+    }
+}
+
+
+/** Gets element[i]. */
+uint64_t PackedArray_get(const PackedArray* pa, size_t i)
+{
+    ASSERT_OP (i, <, pa->n);
+
+    return getAt(pa, i);
+}
+
+//-----------------------------------------------------------------------------
+
+/** Packs values into elements [0, \a n). Whole words are assembled in a
+ *      register and stored once; only the last partial word is merged.
+ * @param[in,out] pa the packed array
+ * @param[in] src the values; higher bits than the width are dropped
+ * @param[in] n the number of values
+ */
+void PackedArray_pack(PackedArray* pa, const uint64_t src[], size_t n)
+{
+    const unsigned width = pa->width;
+    const uint64_t mask = pa->mask;
+    uint64_t* w = pa->w;
+    uint64_t acc = 0;       // bits of the word being assembled
+    unsigned filled = 0;    // the number of bits in acc
+    size_t i;
+
+    ASSERT_OP (n, <=, pa->n);
+
+    for (i=0; i<n; ++i) {
+        const uint64_t val = src[i] & mask;
+
+        acc |= val << filled;
+        filled += width;
+        if (filled >= 64) {
+            *w++ = acc;
+            filled -= 64;
+            acc = (filled > 0) ? val >> (width - filled) : 0;
+        }
+    }
+    if (filled > 0)
+        *w = (*w & ~LOW_MASK64(filled)) | acc;
+}
+
+
+/** Unpacks elements [0, \a n) into an array of values.
+ * @param[in] pa the packed array
+ * @param[out] dst the values
+ * @param[in] n the number of values
+ */
+void PackedArray_unpack(const PackedArray* pa, uint64_t dst[], size_t n)
+{
+    size_t i;
+
+    ASSERT_OP (n, <=, pa->n);
+
+    if (pa->width == 64) {
+        memcpy(dst, pa->w, n * sizeof(uint64_t));
+        return;
+    }
+    for (i=0; i<n; ++i)
+        dst[i] = getAt(pa, i);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file PackedArray.h
+ *      Interface of an array of unsigned integers packed at any bit width
+ *      from 1 to 64.
+ *
+ *      Element \em i occupies bits [i*width, (i+1)*width) of an array of
+ *      64-bit words, so it lies in one word or straddles two; it is read and
+ *      written by shifts and masks, never bit by bit. The bulk
+ *      PackedArray_pack() and PackedArray_unpack() stream whole words.
+ * @note Host only: needs uint64_t.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see PackedArray.c
+ * @see PackedArray_test.c
+ */
+#ifndef _PACKED_ARRAY_H_
+#define _PACKED_ARRAY_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include "platform.h"
+
+
+/// Returns the number of words that \a n elements of \a width bits need.
+#define PACKEDARRAY_WORDS(n, width)     (((n) * (width) + 63) / 64)
+
+
+typedef struct {
+    uint64_t* w;        ///< the words
+    size_t n;           ///< the number of elements
+    unsigned width;     ///< bits of an element
+    uint64_t mask;      ///< the maximum value of an element
+} PackedArray;
+
+
+void PackedArray_init(PackedArray*, uint64_t w[], size_t n, unsigned width);
+
+void PackedArray_set(PackedArray*, size_t i, uint64_t val);
+uint64_t PackedArray_get(const PackedArray*, size_t i);
+
+void PackedArray_pack(PackedArray*, const uint64_t src[], size_t n);
+void PackedArray_unpack(const PackedArray*, uint64_t dst[], size_t n);
+
+#endif // _PACKED_ARRAY_H_
+
+/** @example PackedArray_test.c
+ *      This is an example of how to use the PackedArray module.
+ */
@@ -0,0 +1,107 @@
+/**
+ * @file PackedArray_test.c
+ *      tests the packed integer array at every width.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see PackedArray.h
+ * @see PackedArray.c
+ */
+#include <stdlib.h>
+
+#include "bitops.h"
+#include "PackedArray.h"
+#include "ToyUnit.h"
+
+/// Returns the number of elements of an array
+#define ElemsOfArray(x) (sizeof(x) / sizeof(x[0]))
+
+enum {
+    N= 301      ///< elements; not a whole number of words at most widths
+};
+
+static uint64_t words[PACKEDARRAY_WORDS(N, 64) + 1];
+static uint64_t values[N];
+static uint64_t out[N];
+
+
+/** Returns a random 64-bit value. */
+static uint64_t random64(void)
+{
+    return ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+}
+
+
+/** Checks pack, unpack, get and set at a width.
+ * @return the number of mismatches.
+ */
+static size_t checkWidth(unsigned width)
+{
+    const uint64_t mask = LOW_MASK64(width);
+    const size_t nWords = PACKEDARRAY_WORDS(N, width);
+    PackedArray pa;
+    size_t errors = 0;
+    size_t i;
+
+    for (i=0; i<ElemsOfArray(words); ++i)
+        words[i] = 0x5A5A5A5A5A5A5A5AULL;
+    for (i=0; i<N; ++i)
+        values[i] = random64();
+    PackedArray_init(&pa, words, N, width);
+
+    PackedArray_pack(&pa, values, N);
+    PackedArray_unpack(&pa, out, N);
+    for (i=0; i<N; ++i) {
+        if (out[i] != (values[i] & mask))
+            ++errors;
+        if (PackedArray_get(&pa, i) != (values[i] & mask))
+            ++errors;
+    }
+    if (words[nWords] != 0x5A5A5A5A5A5A5A5AULL)    // the word after
+        ++errors;
+
+    // single sets leave the neighbours alone
+    for (i=0; i<N; i+=7)
+        PackedArray_set(&pa, i, ~values[i] & mask);
+    for (i=0; i<N; ++i) {
+        const uint64_t expected = (i % 7 == 0) ? ~values[i] & mask
+                                               : values[i] & mask;
+        if (PackedArray_get(&pa, i) != expected)
+            ++errors;
+    }
+
+    // a partial pack keeps the elements after it
+    PackedArray_pack(&pa, values, 10);
+    if (PackedArray_get(&pa, 9) != (values[9] & mask)
+            || PackedArray_get(&pa, 14) != (~values[14] & mask))
+        ++errors;
+    return errors;
+}
+
+
+int main()
+{
+    PackedArray pa;
+    unsigned width;
+
+    PackedArray_init(&pa, words, 10, 3);
+    TU_ASSERT("t1-1", pa.mask == 7);
+    PackedArray_set(&pa, 0, 5);
+    PackedArray_set(&pa, 1, 2);
+    TU_ASSERT("t1-2", (words[0] & 0x3F) == 0x15);
+    TU_ASSERT("t1-3", PackedArray_get(&pa, 0) == 5);
+    TU_ASSERT("t1-4", PackedArray_get(&pa, 1) == 2);
+
+    PackedArray_init(&pa, words, 3, 40);
+    PackedArray_set(&pa, 1, 0xFFFFFFFFFFULL);       // straddles two words
+    TU_ASSERT("t2-1", PackedArray_get(&pa, 1) == 0xFFFFFFFFFFULL);
+    TU_ASSERT("t2-2", words[0] >> 40 == 0xFFFFFF);
+    TU_ASSERT("t2-3", (words[1] & 0xFFFF) == 0xFFFF);
+
+    srand(5);
+    for (width=1; width<=64; ++width)
+        TU_ASSERT("t3-1", checkWidth(width) == 0);
+
+    TU_RESULT();
+
+    return 0;
+}
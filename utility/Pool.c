@@ -0,0 +1,119 @@
+/**
+ * @file Pool.c
+ *      Implements a fixed-size block pool allocator over a Bitmap free map.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see Pool.h
+ * @see Pool_test.c
+ */
+#include "assertions.h"
+#include "Pool.h"
+
+
+/** Initializes a pool with all blocks free.
+ * @param[out] pool the pool
+ * @param[in] blocks the storage of \a nBlocks blocks of \a blockSize bytes;
+ *      aligned to #POOL_ALIGN
+ * @param[in] blockSize bytes per block; a multiple of #POOL_ALIGN, see
+ *      POOL_BLOCK_SIZE()
+ * @param[in] nBlocks the number of blocks
+ * @param[in] freeMap the storage of the free map
+ * @param[in] nMapSlots the number of elements of \a freeMap; at least
+ *      BITMAP_NSLOTS(nBlocks)
+ */
+void Pool_init(Pool* pool, void* blocks, size_t blockSize, Index nBlocks,
+               Elem freeMap[], size_t nMapSlots)
+{
+    ASSERT_OP (blockSize, >, 0);
+    ASSERT_OP (blockSize % POOL_ALIGN, ==, 0);
+    ASSERT_OP ((size_t)blocks % POOL_ALIGN, ==, 0);
+    ASSERT_OP (nBlocks, >, 0);
+    ASSERT_OP (nMapSlots, >=, BITMAP_NSLOTS(nBlocks));
+
+    pool->blocks = (Byte*)blocks;
+    pool->blockSize = blockSize;
+    pool->nBlocks = nBlocks;
+    pool->nFree = nBlocks;
+    pool->cursor = 0;
+
+    Bitmap_init(&pool->freeMap, freeMap, nMapSlots);
+    Bitmap_clearAllBits(&pool->freeMap);
+    Bitmap_setRange(&pool->freeMap, 0, nBlocks);
+}
+
+
+/** Allocates a block.
+ * It takes at most ceil(nBlocks / W) + 1 word loads of the free map, W
+ * being the Bitmap word width; see Pool.h.
+ * @param[in,out] pool the pool
+ * @return the block; NULL if the pool is exhausted
+ */
+void* Pool_alloc(Pool* pool)
+{
+    Index i;
+
+    if (pool->nFree == 0)
+        return NULL;
+
+    i = Bitmap_findRisenBitRingedly(&pool->freeMap, pool->cursor,
+                                    pool->nBlocks);
+    ASSERT_OP (i, <, pool->nBlocks);
+
+    Bitmap_clrBit(&pool->freeMap, i);
+    --pool->nFree;
+    pool->cursor = (i + 1 == pool->nBlocks) ? 0 : i + 1;
+    return pool->blocks + i * pool->blockSize;
+}
+
+
+/** Frees a block.
+ * @param[in,out] pool the pool
+ * @param[in] p the block, returned by Pool_alloc() of the same pool
+ * @retval true if the block is freed.
+ * @retval false if \a p is not a block of the pool, or is already free
+ *      (a double free); the pool is unchanged.
+ */
+bool Pool_free(Pool* pool, void* p)
+{
+    Index i;
+
+    if (!Pool_owns(pool, p))
+        return false;
+
+    i = (Index)(((Byte*)p - pool->blocks) / pool->blockSize);
+    if (Bitmap_getBit(&pool->freeMap, i))
+        return false;
+
+    Bitmap_setBit(&pool->freeMap, i);
+    ++pool->nFree;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+/** Returns the number of free blocks. */
+Index Pool_available(const Pool* pool)
+{
+    return pool->nFree;
+}
+
+
+/** Returns the number of blocks. */
+Index Pool_capacity(const Pool* pool)
+{
+    return pool->nBlocks;
+}
+
+
+/** Determines if \a p is the start of a block of the pool. */
+bool Pool_owns(const Pool* pool, const void* p)
+{
+    const Byte* b = (const Byte*)p;
+    size_t offset;
+
+    if (b < pool->blocks || b >= pool->blocks + pool->nBlocks * pool->blockSize)
+        return false;
+    offset = (size_t)(b - pool->blocks);
+    return offset % pool->blockSize == 0;
+}
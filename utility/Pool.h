@@ -0,0 +1,108 @@
+/**
+ * @file Pool.h
+ *      Interface of a fixed-size block pool allocator whose free map is a
+ *      Bitmap (a risen bit is a free block).
+ *
+ *      An allocation searches a free block ringedly from the block after the
+ *      last allocated one, with Bitmap_findRisenBitRingedly(); a free checks
+ *      the block is the pool's and was allocated, in constant time.
+ *      The allocation is deterministic but not constant-time: it stops at
+ *      the first word with a free block, and once the pool is fragmented it
+ *      may load every word of the free map, ceil(nBlocks / W) + 1 words
+ *      where W is 64 on a host and 8 on an 8-bit target. A pool of 64
+ *      blocks or fewer on a host is thus at most 2 word loads.
+ *
+ *      There is no heap: the blocks and the free map are given by the
+ *      caller, or declared by POOL_STORAGE(). Every block starts on a #POOL_ALIGN boundary, so it can hold an
+ *      object of any type.
+ * @code
+ * POOL_STORAGE(msgs, sizeof(Msg), 16);
+ *
+ * Pool pool;
+ * Msg* m;
+ * POOL_INIT(&pool, msgs, sizeof(Msg), 16);
+ * m = (Msg*)Pool_alloc(&pool);
+ * Pool_free(&pool, m);
+ * @endcode
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see Pool.c
+ * @see Pool_test.c
+ */
+#ifndef _POOL_H_
+#define _POOL_H_
+
+
+#include <stddef.h>
+#include "platform.h"
+#include "Bitmap.h"
+
+
+#ifndef POOL_MEM
+    #define POOL_MEM    ///< memory type of static pools, e.g. xdata on C51
+#endif
+
+/// A union of the most strictly aligned basic types; the block storage is
+/// an array of it.
+typedef union {
+    long double ld;
+    void* p;
+    void (*fp)(void);
+    long l;
+#if defined(UINT64_MAX)
+    uint64_t u64;
+#endif
+} PoolAlign;
+
+/// Probes the alignment of #PoolAlign by the padding before it.
+typedef struct {
+    char c;
+    PoolAlign a;
+} PoolAlignProbe;
+
+/// The alignment of the blocks and the block sizes of a pool
+#define POOL_ALIGN      offsetof(PoolAlignProbe, a)
+
+/// Rounds a block size of \a size bytes up to a multiple of #POOL_ALIGN.
+#define POOL_BLOCK_SIZE(size)                                               \
+    (((size) + POOL_ALIGN - 1) / POOL_ALIGN * POOL_ALIGN)
+
+/// Declares the static storage of a pool of \a nBlocks blocks of \a size.
+#define POOL_STORAGE(name, size, nBlocks)                                   \
+    static POOL_MEM PoolAlign name##_blocks[                                \
+        (POOL_BLOCK_SIZE(size) * (nBlocks) + sizeof(PoolAlign) - 1)         \
+        / sizeof(PoolAlign)];                                               \
+    static POOL_MEM Elem name##_freeMap[BITMAP_NSLOTS(nBlocks)]
+
+/// Initializes a pool over the storage declared by POOL_STORAGE().
+#define POOL_INIT(pool, name, size, nBlocks)                                \
+    Pool_init(pool, name##_blocks, POOL_BLOCK_SIZE(size), nBlocks,          \
+              name##_freeMap, BITMAP_NSLOTS(nBlocks))
+
+
+typedef struct {
+    Byte* blocks;       ///< the storage of the blocks
+    size_t blockSize;   ///< bytes per block
+    Index nBlocks;      ///< the number of blocks
+    Index nFree;        ///< the number of free blocks
+    Index cursor;       ///< where the next search starts
+    Bitmap freeMap;     ///< bit[i] is risen if block[i] is free
+} Pool;
+
+
+void Pool_init(Pool*, void* blocks, size_t blockSize, Index nBlocks,
+               Elem freeMap[], size_t nMapSlots);
+
+void* Pool_alloc(Pool*);
+bool Pool_free(Pool*, void* p);
+
+Index Pool_available(const Pool*);
+Index Pool_capacity(const Pool*);
+bool Pool_owns(const Pool*, const void* p);
+
+#endif // _POOL_H_
+
+/** @example Pool_test.c
+ *      This is an example of how to use the Pool allocator.
+ */
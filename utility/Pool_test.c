@@ -0,0 +1,79 @@
+/**
+ * @file Pool_test.c
+ *      tests the fixed-size block pool allocator.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see Pool.h
+ * @see Pool.c
+ */
+#include "ToyUnit.h"
+#include "Pool.h"
+
+/// a fixed-size object
+typedef struct {
+    int id;
+    char name[6];
+} Obj;
+
+enum {
+    N_OBJS= 10      ///< not a multiple of 8, so the map has spare bits
+};
+
+/// the bytes per block of an Obj
+#define OBJ_BLOCK   POOL_BLOCK_SIZE(sizeof(Obj))
+
+POOL_STORAGE(objs, sizeof(Obj), N_OBJS);
+
+
+int main()
+{
+    Pool pool;
+    Obj* o[N_OBJS];
+    Obj* x;
+    int i;
+
+    POOL_INIT(&pool, objs, sizeof(Obj), N_OBJS);
+    TU_ASSERT("t1-1", Pool_capacity(&pool) == N_OBJS);
+    TU_ASSERT("t1-2", Pool_available(&pool) == N_OBJS);
+
+    for (i=0; i<N_OBJS; ++i) {
+        o[i] = (Obj*)Pool_alloc(&pool);
+        o[i]->id = i;
+    }
+    TU_ASSERT("t2-1", o[0] == (Obj*)objs_blocks);
+    TU_ASSERT("t2-2", (char*)o[1] == (char*)o[0] + OBJ_BLOCK);
+    TU_ASSERT("t2-3", (char*)o[N_OBJS-1] == (char*)o[0] + (N_OBJS-1)*OBJ_BLOCK);
+    for (i=0; i<N_OBJS; ++i)
+        TU_ASSERT("t2-9", (size_t)o[i] % POOL_ALIGN == 0);
+    TU_ASSERT("t2-4", Pool_available(&pool) == 0);
+    TU_ASSERT("t2-5", Pool_alloc(&pool) == NULL);
+    TU_ASSERT("t2-6", Pool_owns(&pool, o[3]));
+    TU_ASSERT("t2-7", !Pool_owns(&pool, &o[3]->name));
+    TU_ASSERT("t2-8", !Pool_owns(&pool, (char*)o[N_OBJS-1] + OBJ_BLOCK));
+
+    TU_ASSERT("t3-1", Pool_free(&pool, o[3]));
+    TU_ASSERT("t3-2", !Pool_free(&pool, o[3]));         // double free
+    TU_ASSERT("t3-3", !Pool_free(&pool, &o[4]->name));  // not a block
+    TU_ASSERT("t3-4", !Pool_free(&pool, &i));           // not the pool's
+    TU_ASSERT("t3-5", Pool_available(&pool) == 1);
+    TU_ASSERT("t3-6", Pool_free(&pool, o[7]));
+
+    // the ring cursor: the search goes on after the last allocation
+    x = (Obj*)Pool_alloc(&pool);
+    TU_ASSERT("t4-1", x == o[3]);
+    TU_ASSERT("t4-2", Pool_free(&pool, o[1]));
+    x = (Obj*)Pool_alloc(&pool);
+    TU_ASSERT("t4-3", x == o[7]);
+    x = (Obj*)Pool_alloc(&pool);
+    TU_ASSERT("t4-4", x == o[1]);                       // wraps around
+    TU_ASSERT("t4-5", Pool_alloc(&pool) == NULL);
+
+    for (i=0; i<N_OBJS; ++i)
+        TU_ASSERT("t5-1", Pool_free(&pool, o[i]));
+    TU_ASSERT("t5-2", Pool_available(&pool) == N_OBJS);
+    TU_ASSERT("t5-3", Pool_alloc(&pool) == o[2]);       // after o[1]
+
+    TU_RESULT();
+
+    return 0;
+}
@@ -6,8 +6,114 @@
  * @date 2006/05/18 (last revision)
  * @version 2.0
  */
+#if defined( Q_STATS ) && (defined( __unix__ ) || defined( __APPLE__ ))
+    #define _POSIX_C_SOURCE 199309L     // for clock_gettime()
+#endif
 #include "Queue.h"
 #include <assert.h>
+#include <string.h>
+#if defined( Q_STATS )
+    #include <stdio.h>
+#endif
+#if defined( Q_STATS_MONOTONIC )
+    #include <time.h>
+#endif
+
+
+#if defined( Q_STATS_MONOTONIC )
+
+/** Returns the current time of the monotonic clock in microseconds. */
+QStatTick Q_monotonicTick( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (QStatTick)ts.tv_sec * 1000000UL + (QStatTick)(ts.tv_nsec / 1000);
+}
+
+#endif // Q_STATS_MONOTONIC
+
+
+#if defined( Q_STATS )
+
+/** Accounts \a n items just put, and starts a latency sample if due.
+ * The sample is the first item put at or after every
+ * #Q_LATENCY_SAMPLE_PERIOD puts; only one item is sampled at a time.
+ */
+static void statPut( Queue* q, size_t n )
+{
+    QueueStats* s= &q->stats;
+    unsigned long due= (s->puts + Q_LATENCY_SAMPLE_PERIOD - 1)
+                     / Q_LATENCY_SAMPLE_PERIOD * Q_LATENCY_SAMPLE_PERIOD;
+
+    if (!s->sampling && due < s->puts + n) {
+        s->sampling= true;
+        s->sampleAhead= q->count - n + (due - s->puts);
+        s->sampleTick= Q_STATS_CLOCK();
+    }
+    s->puts += n;
+    if (q->count > s->highWater)
+        s->highWater= q->count;
+}
+
+
+/** Accounts \a n items just gotten, and ends the latency sample if it is
+ *  among them.
+ */
+static void statGet( Queue* q, size_t n )
+{
+    QueueStats* s= &q->stats;
+
+    if (s->sampling) {
+        if (s->sampleAhead < n) {
+            QStatTick ticks= Q_STATS_CLOCK() - s->sampleTick;
+            size_t k= 0;
+
+            while (ticks != 0 && k < Q_LATENCY_BUCKETS-1) {
+                ++k;
+                ticks >>= 1;
+            }
+            ++s->latency[k];
+            s->sampling= false;
+        }
+        else
+            s->sampleAhead -= n;
+    }
+    s->gets += n;
+}
+
+#endif // Q_STATS
+
+
+#if defined( Q_OVERWRITE )
+
+/// Determines if a put on a full queue drops the oldest item.
+#define OVERWRITING( q )    ((q)->overwrite)
+
+/** Drops the \a n oldest items of a queue to make room in overwrite mode.
+ */
+static void dropOldest( Queue* q, size_t n )
+{
+    q->count -= n;
+    q->first += n;
+    if (q->first >= q->buf_size)
+        q->first -= q->buf_size;
+    q->dropped += n;
+    Q_STAT(
+        if (q->stats.sampling) {
+            if (q->stats.sampleAhead < n)
+                q->stats.sampling= false;
+            else
+                q->stats.sampleAhead -= n;
+        }
+    )
+}
+
+#else
+
+#define OVERWRITING( q )    false
+
+#endif // Q_OVERWRITE
 
 
 /** Initilizes a queue.
@@ -22,29 +128,44 @@ void Q_init( Queue* q, QueueItem* buf, size_t buf_size )
     q->count= 0;
     q->buf= buf;
     q->buf_size= buf_size;
+#if defined( Q_OVERWRITE )
+    q->overwrite= false;
+    q->dropped= 0;
+#endif
+    Q_resetStats(q);
 }
 
 
-/** Clear the queue */
+/** Clear the queue, and the count of dropped items in overwrite mode */
 void Q_clear( Queue* q )
 {
     q->first= 0;
     q->end= 0;
     q->count= 0;
+#if defined( Q_OVERWRITE )
+    q->dropped= 0;
+#endif
+    Q_STAT( q->stats.sampling= false; )
 }
 
 
 /** Puts an item to the end of a queue.
+ * In overwrite mode, a full queue drops its oldest item first.
  * @param[in,out] q the queue to add an item.
  * @param[in] i the added item.
  */
 void Q_put( Queue* q, QueueItem i )
 {
+#if defined( Q_OVERWRITE )
+    if (q->overwrite && Q_full(q))
+        dropOldest(q, 1);
+#endif
     assert (!Q_full(q));
 
     ++q->count;
     q->buf[q->end]= i;
     q->end= (q->end+1) % q->buf_size;
+    Q_STAT( statPut(q, 1); )
 }
 
 
@@ -60,16 +181,124 @@ QueueItem Q_get( Queue* q )
     --q->count;
     i= q->buf[q->first];
     q->first= (q->first+1) % q->buf_size;
+    Q_STAT( statGet(q, 1); )
     return i;
 }
 
 
+/** Puts an item to the end of a queue if there is room.
+ * Unlike Q_put(), a full queue is not a caller error: the item is refused
+ * and counted in \c fullRejects of the statistics.
+ * @param[in,out] q the queue to add an item.
+ * @param[in] i the added item.
+ * @retval true if the item is put.
+ * @retval false if the queue is full.
+ */
+bool Q_tryPut( Queue* q, QueueItem i )
+{
+    if (Q_full(q) && !OVERWRITING(q)) {
+        Q_STAT( ++q->stats.fullRejects; )
+        return false;
+    }
+    Q_put(q, i);
+    return true;
+}
+
+
+/** Gets the first item of a queue if there is one.
+ * Unlike Q_get(), an empty queue is not a caller error: the get is refused
+ * and counted in \c emptyRejects of the statistics.
+ * @param[in,out] q the queue to get an item.
+ * @param[out] i the gotten item.
+ * @retval true if an item is gotten.
+ * @retval false if the queue is empty.
+ */
+bool Q_tryGet( Queue* q, QueueItem* i )
+{
+    if (Q_empty(q)) {
+        Q_STAT( ++q->stats.emptyRejects; )
+        return false;
+    }
+    *i= Q_get(q);
+    return true;
+}
+
+
+/** Puts up to \a n items to the end of a queue.
+ * The items are copied in at most two contiguous runs around the wrap point.
+ * In overwrite mode, the oldest items are dropped to make room, and only
+ * the last \a buf_size items are kept if \a n exceeds the buffer size.
+ * @param[in,out] q the queue to add items.
+ * @param[in] items the added items.
+ * @param[in] n the number of items to add.
+ * @return the number of items put; less than \a n if the queue gets full.
+ */
+size_t Q_putN( Queue* q, const QueueItem* items, size_t n )
+{
+    QueueSpan s;
+    size_t run;
+
+#if defined( Q_OVERWRITE )
+    if (q->overwrite && n > q->buf_size - q->count) {
+        if (n > q->buf_size) {
+            q->dropped += n - q->buf_size;
+            items += n - q->buf_size;
+            n= q->buf_size;
+        }
+        dropOldest(q, n - (q->buf_size - q->count));
+    }
+#endif
+
+    if (n > Q_reserveSpan(q, &s)) {
+        Q_STAT( q->stats.fullRejects += n - (s.len[0] + s.len[1]); )
+        n= s.len[0] + s.len[1];
+    }
+
+    run= (n < s.len[0]) ? n : s.len[0];
+    memcpy(s.seg[0], items, run * sizeof(QueueItem));
+    memcpy(s.seg[1], items + run, (n - run) * sizeof(QueueItem));
+    Q_commit(q, n);
+    return n;
+}
+
+
+/** Gets up to \a n items from the front of a queue.
+ * The items are copied out in at most two contiguous runs around the wrap
+ * point.
+ * @param[in,out] q the queue to get items.
+ * @param[out] items the gotten items.
+ * @param[in] n the number of items to get.
+ * @return the number of items gotten; less than \a n if the queue gets empty.
+ */
+size_t Q_getN( Queue* q, QueueItem* items, size_t n )
+{
+    QueueSpan s;
+    size_t run;
+
+    if (n > Q_peekSpan(q, &s)) {
+        Q_STAT( q->stats.emptyRejects += n - (s.len[0] + s.len[1]); )
+        n= s.len[0] + s.len[1];
+    }
+
+    run= (n < s.len[0]) ? n : s.len[0];
+    memcpy(items, s.seg[0], run * sizeof(QueueItem));
+    memcpy(items + run, s.seg[1], (n - run) * sizeof(QueueItem));
+    Q_consume(q, n);
+    return n;
+}
+
+
 /** Rolls back a "get" operation.
  * This cannot work correctly next to 'clear' operation.
  * @return the previous character
  */
 QueueItem Q_unget( Queue* q )
 {
+    Q_STAT(
+        --q->stats.gets;
+        if (q->stats.sampling)
+            ++q->stats.sampleAhead;
+    )
     ++q->count;
     if (q->first == 0)
         q->first= q->buf_size - 1;
@@ -108,6 +337,173 @@ QueueItem Q_last( const Queue* q )
 }
 
 
+/** Peeks the item at offset \a i from the front of a queue.
+ * @param[in] q the queue.
+ * @param[in] i the offset; it must be less than the size.
+ * @return the peeked item
+ */
+QueueItem Q_at( const Queue* q, size_t i )
+{
+    assert (i < q->count);
+
+    i += q->first;
+    if (i >= q->buf_size)
+        i -= q->buf_size;
+    return q->buf[i];
+}
+
+
+/** Searches a queue for an item without consuming anything, e.g. for the
+ *  '\\n' that ends a line. Each of the two readable segments is
+ *  scanned with memchr(), which assumes a byte-sized QueueItem.
+ * @param[in] q the queue.
+ * @param[in] value the item to search for.
+ * @param[in] from the offset from the front to start at.
+ * @return the offset of the first matching item at or after \a from;
+ * @return the size of the queue if not found.
+ */
+size_t Q_find( const Queue* q, QueueItem value, size_t from )
+{
+    QueueSpan s;
+    const QueueItem* p;
+    size_t size= Q_peekSpan(q, &s);
+
+    if (from >= size)
+        return size;
+
+    if (from < s.len[0]) {
+        p= memchr(s.seg[0] + from, value, s.len[0] - from);
+        if (p != NULL)
+            return p - s.seg[0];
+        from= s.len[0];
+    }
+    p= memchr(s.seg[1] + (from - s.len[0]), value, size - from);
+    return (p != NULL) ? s.len[0] + (p - s.seg[1]) : size;
+}
+
+
+#if defined( Q_OVERWRITE )
+
+/** Sets the overwrite (lossy ring) mode of a queue.
+ * In this mode a put on a full queue overwrites the oldest item and counts
+ * it as dropped, so the most recent items are kept and a producer never
+ * waits. A consumer detects the gap with Q_takeDropped().
+ * The mode is compiled in only if \c Q_OVERWRITE is defined, so a queue
+ * without it pays no extra field or branch.
+ * @param[in,out] q the queue.
+ * @param[in] overwrite true to overwrite; false to reject (the default).
+ */
+void Q_setOverwrite( Queue* q, bool overwrite )
+{
+    q->overwrite= overwrite;
+}
+
+
+/** Returns the number of items dropped in overwrite mode so far. */
+size_t Q_dropped( const Queue* q )
+{
+    return q->dropped;
+}
+
+
+/** Returns and resets the number of dropped items.
+ * A non-zero result means items were lost just before the current first
+ * item of the queue.
+ */
+size_t Q_takeDropped( Queue* q )
+{
+    size_t n= q->dropped;
+
+    q->dropped= 0;
+    return n;
+}
+
+#endif // Q_OVERWRITE
+
+
+/** Peeks the readable items of a queue without copying them.
+ * @param[in] q the queue to peek.
+ * @param[out] s the segments holding the items, in queue order.
+ * @return the total number of readable items.
+ * @see Q_consume()
+ */
+size_t Q_peekSpan( const Queue* q, QueueSpan* s )
+{
+    const size_t run= q->buf_size - q->first;
+
+    s->seg[0]= q->buf + q->first;
+    s->seg[1]= q->buf;
+    if (q->count <= run) {
+        s->len[0]= q->count;
+        s->len[1]= 0;
+    }
+    else {
+        s->len[0]= run;
+        s->len[1]= q->count - run;
+    }
+    return q->count;
+}
+
+
+/** Removes \a n items from the front of a queue.
+ * @param[in,out] q the queue to remove items.
+ * @param[in] n the number of removed items; it cannot exceed the size.
+ * @see Q_peekSpan()
+ */
+void Q_consume( Queue* q, size_t n )
+{
+    assert (n <= q->count);
+
+    q->count -= n;
+    q->first += n;
+    if (q->first >= q->buf_size)
+        q->first -= q->buf_size;
+    Q_STAT( statGet(q, n); )
+}
+
+
+/** Reserves the free space of a queue to be written in place.
+ * @param[in] q the queue to write.
+ * @param[out] s the free segments, in queue order.
+ * @return the total number of free items.
+ * @see Q_commit()
+ */
+size_t Q_reserveSpan( const Queue* q, QueueSpan* s )
+{
+    const size_t room= q->buf_size - q->count;
+    const size_t run= q->buf_size - q->end;
+
+    s->seg[0]= q->buf + q->end;
+    s->seg[1]= q->buf;
+    if (room <= run) {
+        s->len[0]= room;
+        s->len[1]= 0;
+    }
+    else {
+        s->len[0]= run;
+        s->len[1]= room - run;
+    }
+    return room;
+}
+
+
+/** Appends \a n items, written in place after Q_reserveSpan(), to a queue.
+ * @param[in,out] q the queue to add items.
+ * @param[in] n the number of added items; it cannot exceed the free space.
+ * @see Q_reserveSpan()
+ */
+void Q_commit( Queue* q, size_t n )
+{
+    assert (n <= q->buf_size - q->count);
+
+    q->count += n;
+    q->end += n;
+    if (q->end >= q->buf_size)
+        q->end -= q->buf_size;
+    Q_STAT( statPut(q, n); )
+}
+
+
 /** Gets the size of a queue at the moment. */
 size_t Q_size( const Queue* q )
 {
@@ -127,3 +523,49 @@ bool Q_full( const Queue* q )
 {
     return q->count == q->buf_size;
 }
+
+
+#if defined( Q_STATS )
+
+/** Returns the statistics of a queue. */
+const QueueStats* Q_stats( const Queue* q )
+{
+    return &q->stats;
+}
+
+
+/** Clears the statistics of a queue. */
+void Q_resetStats( Queue* q )
+{
+    memset(&q->stats, 0, sizeof(q->stats));
+    q->stats.highWater= q->count;
+}
+
+
+/** Prints the statistics of a queue, e.g. from a menu command.
+ * @param[in] q the queue.
+ * @param[in] name the name shown in the heading.
+ */
+void Q_dumpStats( const Queue* q, const char* name )
+{
+    const QueueStats* s= &q->stats;
+    size_t k;
+
+    printf("Queue %s: size %u/%u, high-water %u\n", name,
+           (unsigned)q->count, (unsigned)q->buf_size,
+           (unsigned)s->highWater);
+    printf("  puts %lu, gets %lu, full rejects %lu, empty rejects %lu\n",
+           s->puts, s->gets, s->fullRejects, s->emptyRejects);
+    printf("  latency (ticks: samples):");
+    for (k=0; k<Q_LATENCY_BUCKETS; ++k) {
+        if (s->latency[k] == 0)
+            continue;
+        if (k == 0)
+            printf(" 0: %lu", s->latency[k]);
+        else
+            printf(" <%lu: %lu", 1UL << k, s->latency[k]);
+    }
+    printf("\n");
+}
+
+#endif // Q_STATS
@@ -15,14 +15,87 @@
 
 typedef char QueueItem; ///< the item type in a queue
 
+
+#if defined( Q_STATS )
+
+#ifndef Q_STATS_CLOCK
+  #if defined( __unix__ ) || defined( __APPLE__ )
+    /// Returns the current time in microseconds of the monotonic clock for
+    /// the latency histogram.
+    #define Q_STATS_CLOCK()  Q_monotonicTick()
+    #define Q_STATS_MONOTONIC
+  #else
+    #include <time.h>
+    /// Returns the current time in ticks for the latency histogram.
+    /// @note clock() counts the CPU time of the process, not the wall time:
+    ///     the time an item waits while the process is blocked or asleep is
+    ///     not counted. Define Q_STATS_CLOCK to a real-time tick of the
+    ///     target (e.g. a timer ISR counter) where that matters.
+    #define Q_STATS_CLOCK()  ((QStatTick)clock())
+  #endif
+#endif
+
+typedef unsigned long QStatTick;    ///< tick type of Q_STATS_CLOCK()
+
+#if defined( Q_STATS_MONOTONIC )
+    QStatTick Q_monotonicTick( void );
+#endif
+
+enum {
+    Q_LATENCY_BUCKETS= 16,      ///< buckets of the latency histogram
+    Q_LATENCY_SAMPLE_PERIOD= 16 ///< samples one of every this many puts
+};
+
+/** Occupancy and latency statistics of a queue. */
+typedef struct {
+    size_t highWater;           ///< the maximum size ever reached.
+    unsigned long fullRejects;  ///< items refused by a full queue.
+    unsigned long emptyRejects; ///< items refused by an empty queue.
+    unsigned long puts;         ///< total items put.
+    unsigned long gets;         ///< total items gotten.
+
+    /// latency[k] counts samples of 2^(k-1) <= ticks < 2^k (k=0: 0 tick).
+    unsigned long latency[Q_LATENCY_BUCKETS];
+
+    bool sampling;              ///< whether a sampled item is in the queue.
+    size_t sampleAhead;         ///< the items ahead of the sample.
+    QStatTick sampleTick;       ///< the time the sample was put.
+} QueueStats;
+
+/// Executes statements only if the statistics are compiled in.
+#define Q_STAT( statement_list )  { statement_list }
+
+#else
+
+#define Q_STAT( statement_list )
+
+#endif // Q_STATS
+
+
 typedef struct {
     Index first;    ///< index of the first (front) item of a queue.
     Index end;      ///< index of the end (last+1) of a queue.
     size_t count;   ///< the number of items in a queue.
     QueueItem* buf; ///< a pointer that indicates the buffer of a queue.
     size_t buf_size;///< buffer size.
+#if defined( Q_OVERWRITE )
+    bool overwrite; ///< whether a put on a full queue drops the oldest item.
+    size_t dropped; ///< the number of items dropped to make room.
+#endif
+#if defined( Q_STATS )
+    QueueStats stats;   ///< the statistics of a queue.
+#endif
 } Queue;
 
+/** Up to two contiguous segments of a queue's buffer.
+ * The second segment is used only if the region wraps around the end of
+ * the buffer; its length is 0 otherwise.
+ */
+typedef struct {
+    QueueItem* seg[2];  ///< the beginning of each segment.
+    size_t len[2];      ///< the number of items of each segment.
+} QueueSpan;
+
 
 void Q_init( Queue* q, QueueItem* buf, size_t buf_size );
 void Q_clear( Queue* );
@@ -30,15 +103,44 @@ void Q_clear( Queue* );
 void Q_put( Queue*, QueueItem );
 QueueItem Q_get( Queue* );
 
+bool Q_tryPut( Queue*, QueueItem );
+bool Q_tryGet( Queue*, QueueItem* );
+
+size_t Q_putN( Queue*, const QueueItem* items, size_t n );
+size_t Q_getN( Queue*, QueueItem* items, size_t n );
+
 QueueItem Q_unget( Queue* );
 
 QueueItem Q_first( const Queue* );
 QueueItem Q_last( const Queue* );
+QueueItem Q_at( const Queue*, size_t i );
+size_t Q_find( const Queue*, QueueItem value, size_t from );
+
+size_t Q_peekSpan( const Queue*, QueueSpan* );
+void Q_consume( Queue*, size_t n );
+
+size_t Q_reserveSpan( const Queue*, QueueSpan* );
+void Q_commit( Queue*, size_t n );
+
+#if defined( Q_OVERWRITE )
+    void Q_setOverwrite( Queue*, bool overwrite );
+    size_t Q_dropped( const Queue* );
+    size_t Q_takeDropped( Queue* );
+#endif
 
 size_t Q_size( const Queue* );
 bool Q_empty( const Queue* );
 bool Q_full( const Queue* );
 
+#if defined( Q_STATS )
+    const QueueStats* Q_stats( const Queue* );
+    void Q_resetStats( Queue* );
+    void Q_dumpStats( const Queue*, const char* name );
+#else
+    #define Q_resetStats( q )           ((void)0)
+    #define Q_dumpStats( q, name )      ((void)0)
+#endif
+
 #endif // _QUEUE_H_
 
 /** @example Queue_test.c
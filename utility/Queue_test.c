@@ -5,6 +5,8 @@
  * @date 2006/05/18
  * @version 2.0
  */
+#include <string.h>
+
 #include "Queue.h"
 #include "ToyUnit.h"
 
@@ -17,6 +19,12 @@ char buf[BUF_SIZE];
 int main()
 {
     Queue q;
+    QueueSpan s;
+    char items[5];
+#if defined( Q_STATS )
+    unsigned long n;
+    size_t k;
+#endif
 
     Q_init( &q, buf, BUF_SIZE );
     TU_ASSERT("03", Q_empty(&q));
@@ -87,6 +95,109 @@ int main()
     TU_ASSERT("104", !Q_full(&q));
     TU_ASSERT("105", Q_size(&q) == 0);
 
+    TU_ASSERT("111", Q_putN(&q, "abcd", 4) == 3);
+    TU_ASSERT("112", Q_full(&q));
+    TU_ASSERT("113", Q_putN(&q, "e", 1) == 0);
+    TU_ASSERT("114", Q_getN(&q, items, 2) == 2);
+    TU_ASSERT("115", memcmp(items, "ab", 2) == 0);
+    TU_ASSERT("116", Q_putN(&q, "xy", 2) == 2);   // wraps around
+    TU_ASSERT("117", Q_last(&q) == 'y');
+    TU_ASSERT("118", Q_getN(&q, items, 5) == 3);  // wraps around
+    TU_ASSERT("119", memcmp(items, "cxy", 3) == 0);
+    TU_ASSERT("120", Q_empty(&q));
+    TU_ASSERT("121", Q_getN(&q, items, 1) == 0);
+    Q_put(&q, 'z');
+    TU_ASSERT("122", Q_first(&q) == 'z');
+
+    Q_clear(&q);
+    TU_ASSERT("131", Q_reserveSpan(&q, &s) == 3);
+    TU_ASSERT("132", s.seg[0] == buf && s.len[0] == 3 && s.len[1] == 0);
+    memcpy(s.seg[0], "ab", 2);
+    Q_commit(&q, 2);
+    TU_ASSERT("133", Q_size(&q) == 2 && Q_last(&q) == 'b');
+    TU_ASSERT("134", Q_peekSpan(&q, &s) == 2);
+    TU_ASSERT("135", s.seg[0] == buf && s.len[0] == 2 && s.len[1] == 0);
+    Q_consume(&q, 1);
+    TU_ASSERT("136", Q_reserveSpan(&q, &s) == 2);
+    TU_ASSERT("137", s.seg[0] == buf+2 && s.len[0] == 1);
+    TU_ASSERT("138", s.seg[1] == buf && s.len[1] == 1);
+    s.seg[0][0]= 'c';
+    s.seg[1][0]= 'd';
+    Q_commit(&q, 2);                                // wraps around
+    TU_ASSERT("139", Q_full(&q) && Q_last(&q) == 'd');
+    TU_ASSERT("140", Q_peekSpan(&q, &s) == 3);
+    TU_ASSERT("141", s.seg[0] == buf+1 && s.len[0] == 2);
+    TU_ASSERT("142", s.seg[1] == buf && s.len[1] == 1);
+    TU_ASSERT("143", memcmp(s.seg[0], "bc", 2) == 0 && s.seg[1][0] == 'd');
+    Q_consume(&q, 3);
+    TU_ASSERT("144", Q_empty(&q) && Q_peekSpan(&q, &s) == 0);
+    TU_ASSERT("145", s.len[0] == 0 && s.len[1] == 0);
+
+#if defined( Q_OVERWRITE )
+    Q_setOverwrite(&q, true);
+    Q_putN(&q, "abc", 3);
+    Q_put(&q, 'd');                                 // drops 'a'
+    TU_ASSERT("171", Q_full(&q) && Q_dropped(&q) == 1);
+    TU_ASSERT("172", Q_first(&q) == 'b' && Q_last(&q) == 'd');
+    TU_ASSERT("173", Q_putN(&q, "ef", 2) == 2);     // drops 'b', 'c'
+    TU_ASSERT("174", Q_takeDropped(&q) == 3 && Q_dropped(&q) == 0);
+    TU_ASSERT("175", Q_getN(&q, items, 3) == 3);
+    TU_ASSERT("176", memcmp(items, "def", 3) == 0);
+    TU_ASSERT("177", Q_putN(&q, "ghijk", 5) == 3);  // keeps the last 3
+    TU_ASSERT("178", Q_takeDropped(&q) == 2);
+    TU_ASSERT("179", Q_getN(&q, items, 3) == 3);
+    TU_ASSERT("180", memcmp(items, "ijk", 3) == 0);
+    Q_putN(&q, "lm", 2);
+    Q_put(&q, 'n');
+    Q_put(&q, 'o');                                 // drops 'l'
+    Q_clear(&q);
+    TU_ASSERT("181", Q_empty(&q) && Q_dropped(&q) == 0);
+    Q_setOverwrite(&q, false);
+#endif
+
+    TU_ASSERT("185", Q_tryPut(&q, 'x') && Q_tryPut(&q, 'y'));
+    TU_ASSERT("186", Q_tryPut(&q, 'z') && !Q_tryPut(&q, 'w'));
+    TU_ASSERT("187", Q_full(&q) && Q_last(&q) == 'z');
+    TU_ASSERT("188", Q_tryGet(&q, &items[0]) && items[0] == 'x');
+    Q_getN(&q, items, 2);
+    TU_ASSERT("189", !Q_tryGet(&q, &items[0]) && Q_empty(&q));
+
+    Q_putN(&q, "a\nb", 3);                 // wraps around
+    TU_ASSERT("191", Q_at(&q, 0) == 'a' && Q_at(&q, 2) == 'b');
+    TU_ASSERT("192", Q_find(&q, '\n', 0) == 1);
+    TU_ASSERT("193", Q_find(&q, '\n', 2) == 3);
+    TU_ASSERT("194", Q_find(&q, 'b', 0) == 2);
+    TU_ASSERT("195", Q_find(&q, 'z', 0) == 3);
+    TU_ASSERT("196", Q_find(&q, 'a', 3) == 3);
+    TU_ASSERT("197", Q_size(&q) == 3);
+    Q_getN(&q, items, 3);
+
+#if defined( Q_STATS )
+    Q_resetStats(&q);
+    TU_ASSERT("151", Q_putN(&q, "abcd", 4) == 3);
+    TU_ASSERT("152", Q_stats(&q)->highWater == 3);
+    TU_ASSERT("153", Q_stats(&q)->fullRejects == 1);
+    TU_ASSERT("154", Q_getN(&q, items, 5) == 3);
+    TU_ASSERT("155", Q_stats(&q)->emptyRejects == 2);
+    TU_ASSERT("156", Q_stats(&q)->puts == 3);
+    TU_ASSERT("157", Q_stats(&q)->gets == 3);
+    for (n=0, k=0; k<Q_LATENCY_BUCKETS; ++k)
+        n += Q_stats(&q)->latency[k];
+    TU_ASSERT("158", n == 1);   // the item put first is sampled
+    Q_put(&q, 'a');
+    TU_ASSERT("159", Q_get(&q) == 'a' && Q_unget(&q) == 'a');
+    TU_ASSERT("160", Q_stats(&q)->gets == 3 && Q_stats(&q)->highWater == 3);
+    Q_clear(&q);
+    Q_putN(&q, "abc", 3);
+    TU_ASSERT("161", !Q_tryPut(&q, 'd'));           // refused, not aborted
+    TU_ASSERT("162", Q_stats(&q)->fullRejects == 2);
+    Q_getN(&q, items, 3);
+    TU_ASSERT("163", !Q_tryGet(&q, &items[0]));
+    TU_ASSERT("164", Q_stats(&q)->emptyRejects == 3);
+    putchar('\n');
+    Q_dumpStats(&q, "q");
+#endif
+
     TU_RESULT();
 
     return 0;
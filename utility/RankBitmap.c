@@ -0,0 +1,178 @@
+/**
+ * @file RankBitmap.c
+ *      Implements a rank/select index over a Bitmap with per-block
+ *      cumulative counts, rebuilt lazily after changes.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see RankBitmap.h
+ * @see RankBitmap_test.c
+ */
+#include "assertions.h"
+#include "bitops.h"
+#include "RankBitmap.h"
+
+
+enum {
+    BLOCK_WORDS = RB_BLOCK_BITS / 64    ///< 64-bit words per block
+};
+
+
+/** Returns word[wi] of a bitmap; bytes beyond the bitmap read as 0. */
+static uint64_t wordAt(const Bitmap* b, size_t wi)
+{
+    const size_t at = wi * 8;
+
+    if (at + 8 <= b->n)
+        return load64le(b->a + at);
+    return loadPartial64le(b->a + at, b->n - at);
+}
+
+
+/** Rebuilds the counts and the samples from the bitmap. */
+static void rebuild(RankBitmap* rb)
+{
+    const size_t nWords = (rb->b->n + 7) / 8;
+    size_t blk, wi;
+    uint32_t count = 0;
+    uint32_t nextSample = 0;    // rank of the next sampled risen bit
+
+    rb->nSamples = 0;
+    for (blk=0; blk<rb->nBlocks; ++blk) {
+        rb->counts[blk] = count;
+        for (wi=blk*BLOCK_WORDS; wi<(blk+1)*BLOCK_WORDS && wi<nWords; ++wi)
+            count += popcount64(wordAt(rb->b, wi));
+        for (; nextSample < count; nextSample += RB_SAMPLE_RATE)
+            rb->samples[rb->nSamples++] = (uint32_t)blk;
+    }
+    rb->counts[rb->nBlocks] = count;
+    rb->stale = false;
+}
+
+
+/** Returns the index of the \a k-th (from 0) set bit of a word. */
+static unsigned selectInWord(uint64_t w, size_t k)
+{
+    for (; k>0; --k)
+        w &= w - 1;     // clears the lowest set bit
+    return ctz64(w);
+}
+
+//-----------------------------------------------------------------------------
+
+/** Initializes a rank/select index over a bitmap. The index is built on
+ *      the first query.
+ * @param[out] rb the index
+ * @param[in] b the indexed bitmap; up to 2^32-1 bits
+ * @param[in] index the storage of the index
+ * @param[in] n the number of entries of \a index; at least
+ *      RANKBITMAP_INDEX_SIZE(Bitmap_totalBits(b))
+ */
+void RankBitmap_init(RankBitmap* rb, Bitmap* b, uint32_t index[], size_t n)
+{
+    const size_t nBits = Bitmap_totalBits(b);
+
+    ASSERT_OP (nBits, <=, UINT32_MAX);
+    ASSERT_OP (n, >=, RANKBITMAP_INDEX_SIZE(nBits));
+
+    rb->b = b;
+    rb->nBlocks = (nBits + RB_BLOCK_BITS - 1) / RB_BLOCK_BITS;
+    rb->counts = index;
+    rb->samples = index + rb->nBlocks + 1;
+    rb->nSamples = 0;
+    rb->stale = true;
+}
+
+
+/** Marks the index stale. Call it after the bitmap was changed other than
+ *      through this module.
+ */
+void RankBitmap_invalidate(RankBitmap* rb)
+{
+    rb->stale = true;
+}
+
+
+/** Sets bit[i] to 1, and marks the index stale. */
+void RankBitmap_setBit(RankBitmap* rb, Index i)
+{
+    Bitmap_setBit(rb->b, i);
+    rb->stale = true;
+}
+
+
+/** Clears bit[i] to 0, and marks the index stale. */
+void RankBitmap_clrBit(RankBitmap* rb, Index i)
+{
+    Bitmap_clrBit(rb->b, i);
+    rb->stale = true;
+}
+
+//-----------------------------------------------------------------------------
+
+/** Returns the total risen bits of the bitmap. */
+size_t RankBitmap_count(RankBitmap* rb)
+{
+    if (rb->stale)
+        rebuild(rb);
+    return rb->counts[rb->nBlocks];
+}
+
+
+/** Counts the risen bits in the range [\em 0, \a end); the same as
+ *      Bitmap_risenBitCount() but in constant time.
+ * @param[in,out] rb the index
+ * @param[in] end the \em limit index of the counted bits (= \em last+1).
+ * @return the count result
+ */
+size_t RankBitmap_rank(RankBitmap* rb, Index end)
+{
+    const size_t blk = end / RB_BLOCK_BITS;
+
+    ASSERT_OP (end, <=, Bitmap_totalBits(rb->b));
+
+    if (rb->stale)
+        rebuild(rb);
+    return rb->counts[blk]
+         + Bitmap_risenBitCountInRange(rb->b, blk * RB_BLOCK_BITS, end);
+}
+
+
+/** Finds the \a k-th (from 0) risen bit.
+ * @param[in,out] rb the index
+ * @param[in] k the rank of the wanted bit
+ * @return the index of the found risen bit;
+ * @return the total bits of the bitmap if there are not \a k+1 risen bits
+ */
+Index RankBitmap_select(RankBitmap* rb, size_t k)
+{
+    size_t lo, hi, wi;
+    size_t j = k / RB_SAMPLE_RATE;
+
+    if (rb->stale)
+        rebuild(rb);
+    if (k >= rb->counts[rb->nBlocks])
+        return Bitmap_totalBits(rb->b);
+
+    // the block is the last one with counts[] <= k, between two samples
+    lo = rb->samples[j];
+    hi = (j + 1 < rb->nSamples) ? rb->samples[j+1] : rb->nBlocks - 1;
+    while (lo < hi) {
+        const size_t mid = (lo + hi + 1) / 2;
+
+        if (rb->counts[mid] <= k)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    k -= rb->counts[lo];
+    for (wi=lo*BLOCK_WORDS; ; ++wi) {
+        const uint64_t w = wordAt(rb->b, wi);
+        const size_t c = popcount64(w);
+
+        if (k < c)
+            return wi * 64 + selectInWord(w, k);
+        k -= c;
+    }
+}
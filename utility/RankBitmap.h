@@ -0,0 +1,66 @@
+/**
+ * @file RankBitmap.h
+ *      Interface of a rank/select index over a Bitmap.
+ *
+ *      The index keeps the number of risen bits before each block of
+ *      #RB_BLOCK_BITS bits, and the block of every #RB_SAMPLE_RATE-th risen
+ *      bit. Rank is then one table lookup plus at most a block of popcounts;
+ *      select narrows a binary search to the blocks between two samples.
+ *      The space overhead is about 6.3% of the bitmap.
+ *
+ *      Changes through RankBitmap_setBit() and RankBitmap_clrBit() only mark
+ *      the index stale; the next rank or select rebuilds it.
+ * @note Host only: needs uint64_t.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see RankBitmap.c
+ * @see RankBitmap_test.c
+ */
+#ifndef _RANK_BITMAP_H_
+#define _RANK_BITMAP_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include "platform.h"
+#include "Bitmap.h"
+
+
+enum {
+    RB_BLOCK_BITS = 512,    ///< bits per counted block (8 words)
+    RB_SAMPLE_RATE = 4096   ///< risen bits per select sample
+};
+
+
+/// Returns the number of index entries a bitmap of \a nb bits needs.
+#define RANKBITMAP_INDEX_SIZE(nb)                           \
+    (((nb) + RB_BLOCK_BITS - 1) / RB_BLOCK_BITS + 1         \
+     + (nb) / RB_SAMPLE_RATE + 1)
+
+
+typedef struct {
+    Bitmap* b;          ///< the indexed bitmap
+    uint32_t* counts;   ///< risen bits before each block; [nBlocks] is total
+    uint32_t* samples;  ///< block of the (j*RB_SAMPLE_RATE)-th risen bit
+    size_t nBlocks;     ///< the number of blocks
+    size_t nSamples;    ///< the number of samples in use
+    bool stale;         ///< the index is out of date
+} RankBitmap;
+
+
+void RankBitmap_init(RankBitmap*, Bitmap* b, uint32_t index[], size_t n);
+void RankBitmap_invalidate(RankBitmap*);
+
+void RankBitmap_setBit(RankBitmap*, Index i);
+void RankBitmap_clrBit(RankBitmap*, Index i);
+
+size_t RankBitmap_count(RankBitmap*);
+size_t RankBitmap_rank(RankBitmap*, Index end);
+Index RankBitmap_select(RankBitmap*, size_t k);
+
+#endif // _RANK_BITMAP_H_
+
+/** @example RankBitmap_test.c
+ *      This is an example of how to use the RankBitmap module.
+ */
@@ -0,0 +1,115 @@
+/**
+ * @file RankBitmap_test.c
+ *      tests the rank/select index against Bitmap counting.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see RankBitmap.h
+ * @see RankBitmap.c
+ */
+#include <stdlib.h>
+
+#include "RankBitmap.h"
+#include "ToyUnit.h"
+
+/// Returns the number of elements of an array
+#define ElemsOfArray(x) (sizeof(x) / sizeof(x[0]))
+
+enum {
+    BYTES= 10003,           ///< a partial last block and word
+    BITS= 8 * BYTES,
+    N_CHECKS= 2000
+};
+
+static Byte a[BYTES];
+static uint32_t rankIndex[RANKBITMAP_INDEX_SIZE(BITS)];
+
+
+/** Compares ranks at random positions with Bitmap_risenBitCount().
+ * @return the number of mismatches.
+ */
+static size_t checkRanks(RankBitmap* rb)
+{
+    size_t errors = 0;
+    size_t k;
+
+    for (k=0; k<N_CHECKS; ++k) {
+        const Index end = (Index)rand() % (BITS + 1);
+
+        if (RankBitmap_rank(rb, end) != Bitmap_risenBitCount(rb->b, end))
+            ++errors;
+    }
+    return errors;
+}
+
+
+/** Checks that select() inverts rank() on every risen bit.
+ * @return the number of mismatches.
+ */
+static size_t checkSelects(RankBitmap* rb)
+{
+    size_t errors = 0;
+    size_t k = 0;
+    Index i;
+
+    for (i=0; i<BITS; ++i) {
+        if (Bitmap_getBit(rb->b, i)) {
+            if (RankBitmap_select(rb, k) != i)
+                ++errors;
+            ++k;
+        }
+    }
+    return errors;
+}
+
+
+int main()
+{
+    Bitmap b;
+    RankBitmap rb;
+    size_t i;
+
+    Bitmap_init(&b, a, BYTES);
+    RankBitmap_init(&rb, &b, rankIndex, ElemsOfArray(rankIndex));
+    TU_ASSERT("t1-1", RankBitmap_count(&rb) == 0);
+    TU_ASSERT("t1-2", RankBitmap_rank(&rb, BITS) == 0);
+    TU_ASSERT("t1-3", RankBitmap_select(&rb, 0) == BITS);
+
+    RankBitmap_setBit(&rb, 5);
+    RankBitmap_setBit(&rb, 700);
+    RankBitmap_setBit(&rb, BITS-1);
+    TU_ASSERT("t2-1", RankBitmap_count(&rb) == 3);
+    TU_ASSERT("t2-2", RankBitmap_rank(&rb, 5) == 0);
+    TU_ASSERT("t2-3", RankBitmap_rank(&rb, 6) == 1);
+    TU_ASSERT("t2-4", RankBitmap_rank(&rb, 701) == 2);
+    TU_ASSERT("t2-5", RankBitmap_rank(&rb, BITS) == 3);
+    TU_ASSERT("t2-6", RankBitmap_select(&rb, 0) == 5);
+    TU_ASSERT("t2-7", RankBitmap_select(&rb, 1) == 700);
+    TU_ASSERT("t2-8", RankBitmap_select(&rb, 2) == BITS-1);
+    TU_ASSERT("t2-9", RankBitmap_select(&rb, 3) == BITS);
+    RankBitmap_clrBit(&rb, 700);
+    TU_ASSERT("t2-10", RankBitmap_rank(&rb, BITS) == 2);
+    TU_ASSERT("t2-11", RankBitmap_select(&rb, 1) == BITS-1);
+
+    // dense random bits, so select() spans many samples
+    srand(3);
+    for (i=0; i<BYTES; ++i)
+        a[i]= (Byte)(rand() & rand());
+    RankBitmap_invalidate(&rb);
+    TU_ASSERT("t3-1", RankBitmap_count(&rb) == Bitmap_risenBitCount(&b, BITS));
+    TU_ASSERT("t3-2", rb.nSamples > 2);
+    TU_ASSERT("t3-3", checkRanks(&rb) == 0);
+    TU_ASSERT("t3-4", checkSelects(&rb) == 0);
+
+    // sparse bits: most blocks are empty
+    Bitmap_clearAllBits(&b);
+    for (i=0; i<BITS; i+=1999)
+        Bitmap_setBit(&b, i);
+    RankBitmap_invalidate(&rb);
+    TU_ASSERT("t4-1", checkRanks(&rb) == 0);
+    TU_ASSERT("t4-2", checkSelects(&rb) == 0);
+    TU_ASSERT("t4-3", RankBitmap_select(&rb, 7) == 7*1999);
+
+    TU_RESULT();
+
+    return 0;
+}
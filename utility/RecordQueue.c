@@ -0,0 +1,179 @@
+/**
+ * @file RecordQueue.c
+ *      Implements a queue of variable-length records on top of the
+ *      storage model of the Queue module.
+ *
+ *      Header layout (the first byte \em h):
+ *      - h < 80h: a record of \em h bytes follows.
+ *      - 80h <= h < FFh: one more byte \em l follows, and then a record of
+ *        ((h & 7Fh) << 8 | \em l) bytes.
+ *      - h = FFh: skip marker; the rest of the buffer is padding.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see RecordQueue.h
+ * @see RecordQueue_test.c
+ */
+#include <string.h>
+
+#include "RecordQueue.h"
+#include "assertions.h"
+
+
+enum {
+    SHORT_MAX= 0x7F,    ///< the maximum length with a one-byte header
+    SKIP= 0xFF          ///< the skip marker
+};
+
+
+/// Returns the header size of a record of \a len bytes.
+#define HEADER_SIZE(len)    (((len) <= SHORT_MAX) ? 1 : 2)
+
+
+/** Initilizes a record queue.
+ * @param[out] rq the queue to be initialized.
+ * @param[in] buf the buffer to store records and their headers.
+ * @param[in] buf_size the buffer size.
+ */
+void RQ_init( RecordQueue* rq, QueueItem* buf, size_t buf_size )
+{
+    Q_init(&rq->q, buf, buf_size);
+    rq->records= 0;
+}
+
+
+/** Clear the record queue */
+void RQ_clear( RecordQueue* rq )
+{
+    Q_clear(&rq->q);
+    rq->records= 0;
+}
+
+
+/** Puts a record to the end of a queue in one call.
+ * @param[in,out] rq the queue to add a record.
+ * @param[in] data the record.
+ * @param[in] len the length of the record; at most #RQ_MAX_RECORD.
+ * @retval true if the record is put.
+ * @retval false if there is no contiguous room for it.
+ */
+bool RQ_put( RecordQueue* rq, const void* data, size_t len )
+{
+    const size_t need= HEADER_SIZE(len) + len;
+    QueueSpan s;
+    Byte* p;
+    size_t skip= 0;
+
+    ASSERT_OP (len, <=, RQ_MAX_RECORD);
+
+    if (Q_empty(&rq->q))
+        Q_clear(&rq->q);    // rewinds for the most contiguous room
+
+    Q_reserveSpan(&rq->q, &s);
+    if (s.len[0] >= need) {
+        p= (Byte*)s.seg[0];
+    }
+    else if (s.len[1] >= need) {
+        *(Byte*)s.seg[0]= SKIP;
+        skip= s.len[0];
+        p= (Byte*)s.seg[1];
+    }
+    else {
+        return false;
+    }
+
+    if (len <= SHORT_MAX) {
+        *p++= (Byte)len;
+    }
+    else {
+        *p++= (Byte)(0x80 | (len >> 8));
+        *p++= (Byte)(len & 0xFF);
+    }
+    memcpy(p, data, len);
+    Q_commit(&rq->q, skip + need);
+    ++rq->records;
+    return true;
+}
+
+
+/** Peeks the first record of a queue in place.
+ * @param[in] rq the queue.
+ * @param[out] len the length of the record.
+ * @return the pointer to the record; NULL if the queue is empty.
+ * @see RQ_pop()
+ */
+const void* RQ_peek( const RecordQueue* rq, size_t* len )
+{
+    QueueSpan s;
+    const Byte* p;
+
+    if (rq->records == 0)
+        return NULL;
+
+    Q_peekSpan(&rq->q, &s);
+    p= (const Byte*)s.seg[0];
+    if (*p == SKIP)
+        p= (const Byte*)s.seg[1];
+
+    if (*p <= SHORT_MAX) {
+        *len= *p;
+        return p + 1;
+    }
+    *len= (size_t)(*p & 0x7F) << 8 | p[1];
+    return p + 2;
+}
+
+
+/** Removes the first record of a queue.
+ * @param[in,out] rq the queue; it cannot be empty.
+ * @see RQ_peek()
+ */
+void RQ_pop( RecordQueue* rq )
+{
+    QueueSpan s;
+    size_t len;
+
+    ASSERT_OP (rq->records, >, 0);
+
+    Q_peekSpan(&rq->q, &s);
+    if (*(const Byte*)s.seg[0] == SKIP)
+        Q_consume(&rq->q, s.len[0]);
+    RQ_peek(rq, &len);
+    Q_consume(&rq->q, HEADER_SIZE(len) + len);
+    --rq->records;
+}
+
+
+/** Gets the first record of a queue by copying it out.
+ * @param[in,out] rq the queue to get a record.
+ * @param[out] data the buffer to receive the record.
+ * @param[in] size the size of \a data.
+ * @param[out] len the length of the gotten record.
+ * @retval true if a record is gotten.
+ * @retval false if the queue is empty, or the record is longer than
+ *      \a size (it is left in the queue and \a len tells its length).
+ */
+bool RQ_get( RecordQueue* rq, void* data, size_t size, size_t* len )
+{
+    const void* p= RQ_peek(rq, len);
+
+    if (p == NULL || *len > size)
+        return false;
+    memcpy(data, p, *len);
+    RQ_pop(rq);
+    return true;
+}
+
+
+/** Gets the number of records in a queue. */
+size_t RQ_size( const RecordQueue* rq )
+{
+    return rq->records;
+}
+
+
+/** Determines if a record queue is empty. */
+bool RQ_empty( const RecordQueue* rq )
+{
+    return rq->records == 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file RecordQueue.h
+ *      Interface of a queue of variable-length records.
+ *
+ *      A record is stored in the byte buffer of a Queue with a length
+ *      header of one byte (lengths below 128) or two bytes (up to
+ *      #RQ_MAX_RECORD). A record never wraps around the end of the buffer;
+ *      the tail room it would straddle is skipped with a marker, so a
+ *      consumer always sees a whole record at one contiguous pointer.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see RecordQueue.c
+ * @see RecordQueue_test.c
+ */
+#ifndef _RECORD_QUEUE_H_
+#define _RECORD_QUEUE_H_
+
+
+#include <stddef.h>
+#include "platform.h"
+#include "Queue.h"
+
+
+enum {
+    RQ_MAX_RECORD= 0x7EFF   ///< the maximum length of a record
+};
+
+typedef struct {
+    Queue q;        ///< the byte storage of the records.
+    size_t records; ///< the number of records in a queue.
+} RecordQueue;
+
+
+void RQ_init( RecordQueue* rq, QueueItem* buf, size_t buf_size );
+void RQ_clear( RecordQueue* );
+
+bool RQ_put( RecordQueue*, const void* data, size_t len );
+
+const void* RQ_peek( const RecordQueue*, size_t* len );
+void RQ_pop( RecordQueue* );
+bool RQ_get( RecordQueue*, void* data, size_t size, size_t* len );
+
+size_t RQ_size( const RecordQueue* );
+bool RQ_empty( const RecordQueue* );
+
+#endif // _RECORD_QUEUE_H_
+
+/** @example RecordQueue_test.c
+ *      This is an example of how to use the RecordQueue module.
+ */
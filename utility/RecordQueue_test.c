@@ -0,0 +1,78 @@
+/**
+ * @file RecordQueue_test.c
+ *      tests the record queue.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see RecordQueue.h
+ * @see RecordQueue.c
+ */
+#include <string.h>
+
+#include "RecordQueue.h"
+#include "ToyUnit.h"
+
+enum {
+    BUF_SIZE= 16,
+    BIG_BUF_SIZE= 512
+};
+
+char buf[BUF_SIZE];
+char bigBuf[BIG_BUF_SIZE];
+
+
+int main()
+{
+    RecordQueue rq;
+    char rec[300];
+    const char* p;
+    size_t len;
+
+    RQ_init( &rq, buf, BUF_SIZE );
+    TU_ASSERT("03", RQ_empty(&rq));
+    TU_ASSERT("04", RQ_size(&rq) == 0);
+    TU_ASSERT("05", RQ_peek(&rq, &len) == NULL);
+    TU_ASSERT("06", !RQ_get(&rq, rec, sizeof(rec), &len));
+
+    TU_ASSERT("11", RQ_put(&rq, "hello", 5));       // buf[0..5]
+    TU_ASSERT("12", RQ_put(&rq, "", 0));            // buf[6]
+    TU_ASSERT("13", RQ_put(&rq, "world!", 6));      // buf[7..13]
+    TU_ASSERT("14", RQ_size(&rq) == 3);
+    TU_ASSERT("15", !RQ_put(&rq, "abc", 3));        // no room
+
+    p= RQ_peek(&rq, &len);
+    TU_ASSERT("21", len == 5 && memcmp(p, "hello", 5) == 0);
+    TU_ASSERT("22", p == buf + 1);
+    RQ_pop(&rq);
+    TU_ASSERT("23", RQ_get(&rq, rec, sizeof(rec), &len) && len == 0);
+
+    // 2 bytes left at the end; the record goes to the front
+    TU_ASSERT("31", RQ_put(&rq, "abcd", 4));
+    TU_ASSERT("32", buf[14] == (char)0xFF);
+    TU_ASSERT("33", !RQ_get(&rq, rec, 3, &len) && len == 6);
+    TU_ASSERT("34", RQ_get(&rq, rec, sizeof(rec), &len));
+    TU_ASSERT("35", len == 6 && memcmp(rec, "world!", 6) == 0);
+    p= RQ_peek(&rq, &len);
+    TU_ASSERT("36", p == buf + 1 && len == 4);
+    TU_ASSERT("37", memcmp(p, "abcd", 4) == 0);
+    RQ_pop(&rq);
+    TU_ASSERT("38", RQ_empty(&rq));
+
+    // long records take a two-byte header
+    RQ_init( &rq, bigBuf, BIG_BUF_SIZE );
+    memset(rec, 'x', sizeof(rec));
+    TU_ASSERT("41", RQ_put(&rq, rec, 300));
+    TU_ASSERT("42", RQ_put(&rq, "tail", 4));
+    p= RQ_peek(&rq, &len);
+    TU_ASSERT("43", p == bigBuf + 2 && len == 300);
+    RQ_pop(&rq);
+    TU_ASSERT("44", RQ_get(&rq, rec, sizeof(rec), &len));
+    TU_ASSERT("45", len == 4 && memcmp(rec, "tail", 4) == 0);
+
+    RQ_put(&rq, "x", 1);
+    RQ_clear(&rq);
+    TU_ASSERT("51", RQ_empty(&rq));
+
+    TU_RESULT();
+
+    return 0;
+}
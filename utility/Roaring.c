@@ -0,0 +1,742 @@
+/**
+ * @file Roaring.c
+ *      Implements a compressed bitmap with array, bitset and run containers.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see Roaring.h
+ * @see Roaring_test.c
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "assertions.h"
+#include "bitops.h"
+#include "Roaring.h"
+
+
+/// Kinds of containers
+enum {
+    RC_ARRAY,
+    RC_BITSET,
+    RC_RUN
+};
+
+enum {
+    CHUNK_BITS = 1 << 16,               ///< bits per container
+    BITSET_WORDS = CHUNK_BITS / 64,     ///< words of a bitset container
+    NONE = -1                           ///< no value
+};
+
+
+/// Returns a word mask of bits [\a r, 64) (0 <= r < 64)
+#define HEAD_MASK(r)    (~(uint64_t)0 << (r))
+
+
+//-----------------------------------------------------------------------------
+// Container operators
+//-----------------------------------------------------------------------------
+
+/** Returns the index of the first value >= \a v of a sorted array. */
+static uint32_t lowerBound(const uint16_t a[], uint32_t n, uint32_t v)
+{
+    uint32_t lo = 0;
+
+    while (lo < n) {
+        const uint32_t mid = lo + (n - lo) / 2;
+
+        if (a[mid] < v)
+            lo = mid + 1;
+        else
+            n = mid;
+    }
+    return lo;
+}
+
+
+/** Returns the index of the first run that ends at or after \a v. */
+static uint32_t runLowerBound(const RoaringRun r[], uint32_t n, uint32_t v)
+{
+    uint32_t lo = 0;
+
+    while (lo < n) {
+        const uint32_t mid = lo + (n - lo) / 2;
+
+        if (r[mid].last < v)
+            lo = mid + 1;
+        else
+            n = mid;
+    }
+    return lo;
+}
+
+
+/** Returns the first value >= \a from of a container, or #NONE. */
+static int32_t nextValue(const RoaringContainer* c, uint32_t from)
+{
+    uint32_t i;
+
+    switch (c->type) {
+    case RC_ARRAY: {
+        const uint16_t* a = (const uint16_t*)c->data;
+
+        i = lowerBound(a, c->n, from);
+        return (i < c->n) ? a[i] : NONE;
+    }
+    case RC_BITSET: {
+        const uint64_t* w = (const uint64_t*)c->data;
+        uint64_t word;
+
+        i = from / 64;
+        for (word = w[i] & HEAD_MASK(from % 64); word == 0; word = w[i]) {
+            if (++i == BITSET_WORDS)
+                return NONE;
+        }
+        return (int32_t)(i * 64 + ctz64(word));
+    }
+    default: {
+        const RoaringRun* r = (const RoaringRun*)c->data;
+
+        i = runLowerBound(r, c->n, from);
+        if (i == c->n)
+            return NONE;
+        return (r[i].start > from) ? r[i].start : (int32_t)from;
+    }
+    }
+}
+
+
+/** Returns the first unset value >= \a from of a bitset, or CHUNK_BITS. */
+static uint32_t nextGap(const uint64_t w[], uint32_t from)
+{
+    uint32_t i = from / 64;
+    uint64_t word = ~w[i] & HEAD_MASK(from % 64);
+
+    while (word == 0) {
+        if (++i == BITSET_WORDS)
+            return CHUNK_BITS;
+        word = ~w[i];
+    }
+    return i * 64 + ctz64(word);
+}
+
+
+/** Determines if a container holds a value. */
+static bool containsValue(const RoaringContainer* c, uint32_t v)
+{
+    return nextValue(c, v) == (int32_t)v;
+}
+
+
+/** Counts the values < \a end of a container. */
+static uint32_t countBelow(const RoaringContainer* c, uint32_t end)
+{
+    uint32_t i, count = 0;
+
+    switch (c->type) {
+    case RC_ARRAY:
+        return lowerBound((const uint16_t*)c->data, c->n, end);
+    case RC_BITSET: {
+        const uint64_t* w = (const uint64_t*)c->data;
+
+        for (i=0; i<end/64; ++i)
+            count += popcount64(w[i]);
+        if (end % 64 != 0)
+            count += popcount64(w[i] & LOW_MASK64(end % 64));
+        return count;
+    }
+    default: {
+        const RoaringRun* r = (const RoaringRun*)c->data;
+
+        for (i=0; i<c->n && r[i].start<end; ++i)
+            count += ((r[i].last < end) ? r[i].last + 1u : end) - r[i].start;
+        return count;
+    }
+    }
+}
+
+
+/** Counts the runs of consecutive values of a container. */
+static uint32_t countRuns(const RoaringContainer* c)
+{
+    uint32_t i, runs = 0;
+
+    switch (c->type) {
+    case RC_ARRAY: {
+        const uint16_t* a = (const uint16_t*)c->data;
+
+        for (i=0; i<c->n; ++i)
+            if (i == 0 || a[i] != a[i-1] + 1)
+                ++runs;
+        return runs;
+    }
+    case RC_BITSET: {
+        const uint64_t* w = (const uint64_t*)c->data;
+        uint64_t carry = 0;     // the top bit of the previous word
+
+        for (i=0; i<BITSET_WORDS; ++i) {
+            runs += popcount64(w[i] & ~((w[i] << 1) | carry));
+            carry = w[i] >> 63;
+        }
+        return runs;
+    }
+    default:
+        return c->n;
+    }
+}
+
+
+/** Replaces the data of a container by new data of a given kind.
+ *      The caller fills the new data.
+ */
+static void replaceData(RoaringContainer* c, uint8_t type, void* data,
+                        uint32_t n, uint32_t cap)
+{
+    free(c->data);
+    c->type = type;
+    c->data = data;
+    c->n = n;
+    c->cap = cap;
+}
+
+
+/** Converts a container to a bitset. */
+static bool toBitset(RoaringContainer* c)
+{
+    uint64_t* w = (uint64_t*)calloc(BITSET_WORDS, sizeof(uint64_t));
+    uint32_t i, v;
+
+    if (w == NULL)
+        return false;
+    if (c->type == RC_ARRAY) {
+        const uint16_t* a = (const uint16_t*)c->data;
+
+        for (i=0; i<c->n; ++i)
+            w[a[i] / 64] |= (uint64_t)1 << (a[i] % 64);
+    } else {
+        const RoaringRun* r = (const RoaringRun*)c->data;
+
+        for (i=0; i<c->n; ++i)
+            for (v=r[i].start; v<=r[i].last; ++v)
+                w[v / 64] |= (uint64_t)1 << (v % 64);
+    }
+    replaceData(c, RC_BITSET, w, BITSET_WORDS, BITSET_WORDS);
+    return true;
+}
+
+
+/** Converts a bitset or run container of at most #ROARING_ARRAY_MAX values
+ *      to an array.
+ */
+static bool toArray(RoaringContainer* c)
+{
+    const uint32_t cap = (c->card > 0) ? c->card : 1;
+    uint16_t* a = (uint16_t*)malloc(cap * sizeof(uint16_t));
+    uint32_t n = 0;
+    int32_t v;
+
+    ASSERT_OP (c->card, <=, ROARING_ARRAY_MAX);
+
+    if (a == NULL)
+        return false;
+    for (v=nextValue(c, 0); v!=NONE; v=nextValue(c, (uint32_t)v + 1)) {
+        a[n++] = (uint16_t)v;
+        if (v == CHUNK_BITS - 1)
+            break;
+    }
+    replaceData(c, RC_ARRAY, a, n, cap);
+    return true;
+}
+
+
+/** Converts a container to runs. */
+static bool toRuns(RoaringContainer* c)
+{
+    const uint32_t nRuns = countRuns(c);
+    RoaringRun* r = (RoaringRun*)malloc((nRuns ? nRuns : 1) * sizeof(RoaringRun));
+    uint32_t n = 0;
+    uint32_t i;
+
+    if (r == NULL)
+        return false;
+    if (c->type == RC_ARRAY) {
+        const uint16_t* a = (const uint16_t*)c->data;
+
+        for (i=0; i<c->n; ++i) {
+            if (n > 0 && a[i] == r[n-1].last + 1) {
+                r[n-1].last = a[i];
+            } else {
+                r[n].start = r[n].last = a[i];
+                ++n;
+            }
+        }
+    } else {
+        const uint64_t* w = (const uint64_t*)c->data;
+        int32_t v;
+
+        for (v=nextValue(c, 0); v!=NONE; ) {
+            const uint32_t gap = nextGap(w, (uint32_t)v);
+
+            r[n].start = (uint16_t)v;
+            r[n].last = (uint16_t)(gap - 1);
+            ++n;
+            v = (gap < CHUNK_BITS) ? nextValue(c, gap) : NONE;
+        }
+    }
+    ASSERT_OP (n, ==, nRuns);
+    replaceData(c, RC_RUN, r, n, nRuns);
+    return true;
+}
+
+
+/** Returns the data size in bytes of a container of a given kind. */
+static size_t dataSize(uint8_t type, uint32_t n)
+{
+    switch (type) {
+    case RC_ARRAY:  return n * sizeof(uint16_t);
+    case RC_BITSET: return BITSET_WORDS * sizeof(uint64_t);
+    default:        return n * sizeof(RoaringRun);
+    }
+}
+
+
+/** Adds a value to a container. */
+static bool addValue(RoaringContainer* c, uint32_t v)
+{
+    if (c->type == RC_RUN) {
+        if (containsValue(c, v))
+            return true;
+        if (!((c->card < ROARING_ARRAY_MAX) ? toArray(c) : toBitset(c)))
+            return false;
+    }
+
+    if (c->type == RC_ARRAY) {
+        uint16_t* a = (uint16_t*)c->data;
+        const uint32_t i = lowerBound(a, c->n, v);
+
+        if (i < c->n && a[i] == v)
+            return true;
+        if (c->n == ROARING_ARRAY_MAX) {
+            if (!toBitset(c))
+                return false;
+            return addValue(c, v);
+        }
+        if (c->n == c->cap) {
+            const uint32_t cap = (c->cap * 2 < ROARING_ARRAY_MAX)
+                               ? c->cap * 2 : ROARING_ARRAY_MAX;
+
+            a = (uint16_t*)realloc(a, cap * sizeof(uint16_t));
+            if (a == NULL)
+                return false;
+            c->data = a;
+            c->cap = cap;
+        }
+        memmove(a + i + 1, a + i, (c->n - i) * sizeof(uint16_t));
+        a[i] = (uint16_t)v;
+        ++c->n;
+        ++c->card;
+    } else {
+        uint64_t* w = (uint64_t*)c->data;
+        const uint64_t bit = (uint64_t)1 << (v % 64);
+
+        if ((w[v / 64] & bit) == 0) {
+            w[v / 64] |= bit;
+            ++c->card;
+        }
+    }
+    return true;
+}
+
+
+/** Removes a value from a container. */
+static bool removeValue(RoaringContainer* c, uint32_t v)
+{
+    if (!containsValue(c, v))
+        return true;
+    if (c->type == RC_RUN) {
+        if (!((c->card <= ROARING_ARRAY_MAX) ? toArray(c) : toBitset(c)))
+            return false;
+    }
+
+    if (c->type == RC_ARRAY) {
+        uint16_t* a = (uint16_t*)c->data;
+        const uint32_t i = lowerBound(a, c->n, v);
+
+        memmove(a + i, a + i + 1, (c->n - i - 1) * sizeof(uint16_t));
+        --c->n;
+        --c->card;
+    } else {
+        uint64_t* w = (uint64_t*)c->data;
+
+        w[v / 64] &= ~((uint64_t)1 << (v % 64));
+        if (--c->card == ROARING_ARRAY_MAX)
+            return toArray(c);
+    }
+    return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Container list
+//-----------------------------------------------------------------------------
+
+/** Returns the index of the first container whose key is >= \a key. */
+static size_t findContainer(const RoaringBitmap* r, uint32_t key)
+{
+    size_t lo = 0, n = r->n;
+
+    while (lo < n) {
+        const size_t mid = lo + (n - lo) / 2;
+
+        if (r->c[mid].key < key)
+            lo = mid + 1;
+        else
+            n = mid;
+    }
+    return lo;
+}
+
+
+/** Inserts an empty array container at c[pos].
+ * @return the container; NULL if out of memory.
+ */
+static RoaringContainer* insertContainer(RoaringBitmap* r, size_t pos,
+                                         uint16_t key)
+{
+    RoaringContainer* c;
+    uint16_t* a = (uint16_t*)malloc(4 * sizeof(uint16_t));
+
+    if (a == NULL)
+        return NULL;
+    if (r->n == r->cap) {
+        const size_t cap = r->cap ? r->cap * 2 : 4;
+
+        c = (RoaringContainer*)realloc(r->c, cap * sizeof(RoaringContainer));
+        if (c == NULL) {
+            free(a);
+            return NULL;
+        }
+        r->c = c;
+        r->cap = cap;
+    }
+    memmove(r->c + pos + 1, r->c + pos, (r->n - pos) * sizeof(RoaringContainer));
+    ++r->n;
+
+    c = &r->c[pos];
+    c->key = key;
+    c->type = RC_ARRAY;
+    c->card = 0;
+    c->n = 0;
+    c->cap = 4;
+    c->data = a;
+    return c;
+}
+
+
+/** Removes the container c[pos]. */
+static void removeContainer(RoaringBitmap* r, size_t pos)
+{
+    free(r->c[pos].data);
+    memmove(r->c + pos, r->c + pos + 1,
+            (r->n - pos - 1) * sizeof(RoaringContainer));
+    --r->n;
+}
+
+
+//-----------------------------------------------------------------------------
+// Bit-wise operators
+//-----------------------------------------------------------------------------
+
+/** Initializes an empty compressed bitmap. */
+void Roaring_init(RoaringBitmap* r)
+{
+    r->c = NULL;
+    r->n = 0;
+    r->cap = 0;
+}
+
+
+/** Frees the memory of a compressed bitmap. */
+void Roaring_destroy(RoaringBitmap* r)
+{
+    Roaring_clearAllBits(r);
+    free(r->c);
+    Roaring_init(r);
+}
+
+
+/** Sets all bits to zero, and frees the containers. */
+void Roaring_clearAllBits(RoaringBitmap* r)
+{
+    size_t i;
+
+    for (i=0; i<r->n; ++i)
+        free(r->c[i].data);
+    r->n = 0;
+}
+
+
+/** Sets bit[i] to 1
+ * @param[in,out] r the compressed bitmap
+ * @param[in] i the index of the \em bit to be set
+ * @retval true if done.
+ * @retval false if out of memory; the bitmap is unchanged.
+ */
+bool Roaring_setBit(RoaringBitmap* r, uint32_t i)
+{
+    const uint16_t key = (uint16_t)(i >> 16);
+    const size_t pos = findContainer(r, key);
+    RoaringContainer* c;
+
+    if (pos < r->n && r->c[pos].key == key)
+        c = &r->c[pos];
+    else if ((c = insertContainer(r, pos, key)) == NULL)
+        return false;
+    if (!addValue(c, i & 0xFFFF)) {
+        if (c->card == 0)
+            removeContainer(r, pos);
+        return false;
+    }
+    return true;
+}
+
+
+/** Clears bit[i] to 0
+ * @param[in,out] r the compressed bitmap
+ * @param[in] i the index of the cleared \em bit
+ * @retval true if done.
+ * @retval false if out of memory (to split a run container).
+ */
+bool Roaring_clrBit(RoaringBitmap* r, uint32_t i)
+{
+    const uint16_t key = (uint16_t)(i >> 16);
+    const size_t pos = findContainer(r, key);
+
+    if (pos == r->n || r->c[pos].key != key)
+        return true;
+    if (!removeValue(&r->c[pos], i & 0xFFFF))
+        return false;
+    if (r->c[pos].card == 0)
+        removeContainer(r, pos);
+    return true;
+}
+
+
+/** Gets bit[i] */
+Bit Roaring_getBit(const RoaringBitmap* r, uint32_t i)
+{
+    const uint16_t key = (uint16_t)(i >> 16);
+    const size_t pos = findContainer(r, key);
+
+    return pos < r->n && r->c[pos].key == key
+        && containsValue(&r->c[pos], i & 0xFFFF);
+}
+
+//-----------------------------------------------------------------------------
+
+/** Counts the total risen bit (value=1) in the range [\em 0, \a end).
+ * @param r the compressed bitmap
+ * @param end the \em limit index of the counted bits (<= 2^32).
+ * @return the count result
+ */
+uint64_t Roaring_risenBitCount(const RoaringBitmap* r, uint64_t end)
+{
+    uint64_t count = 0;
+    size_t i;
+
+    ASSERT_OP (end, <=, ROARING_UNIVERSE);
+
+    for (i=0; i<r->n; ++i) {
+        const uint64_t base = (uint64_t)r->c[i].key << 16;
+
+        if (base + CHUNK_BITS <= end) {
+            count += r->c[i].card;
+        } else {
+            if (base < end)
+                count += countBelow(&r->c[i], (uint32_t)(end - base));
+            break;
+        }
+    }
+    return count;
+}
+
+
+/** Finds the 1st risen bit (value=1) in the range [\a begin, \a end).
+ * @param r the compressed bitmap
+ * @param begin the index of the \a begin search bit
+ * @param end the \em limit index of the searched bits (<= 2^32).
+ * @return the index of the found risen bit;
+ * @return \a end if not found
+ */
+uint64_t Roaring_findRisenBit(const RoaringBitmap* r, uint64_t begin,
+                              uint64_t end)
+{
+    size_t pos;
+
+    ASSERT_OP (begin, <=, end);
+    ASSERT_OP (end, <=, ROARING_UNIVERSE);
+
+    if (begin == end)
+        return end;
+    for (pos=findContainer(r, (uint32_t)(begin >> 16)); pos<r->n; ++pos) {
+        const uint64_t base = (uint64_t)r->c[pos].key << 16;
+        int32_t v;
+
+        if (base >= end)
+            break;
+        v = nextValue(&r->c[pos], (begin > base) ? (uint32_t)(begin - base) : 0);
+        if (v != NONE)
+            return (base + (uint32_t)v < end) ? base + (uint32_t)v : end;
+    }
+    return end;
+}
+
+
+/** Finds a risen bit (value=1) in a ring-shaped compressed bitmap.
+ *      - It first searches the bits in [\a begin, \a end);
+ *      - if not found, re-searches the bits in [\a 0, \a begin).
+ *
+ * @return the index of the found risen bit;
+ * @return \a end if not found
+ */
+uint64_t Roaring_findRisenBitRingedly(const RoaringBitmap* r, uint64_t begin,
+                                      uint64_t end)
+{
+    uint64_t i = Roaring_findRisenBit(r, begin, end);
+    if (i == end) {
+        i = Roaring_findRisenBit(r, 0, begin);
+        if (i == begin)
+            return end;
+    }
+    return i;
+}
+
+//-----------------------------------------------------------------------------
+
+/** Converts each container to the smallest of array, bitset and runs.
+ * @retval true if done.
+ * @retval false if out of memory; the bitmap holds the same bits.
+ */
+bool Roaring_optimize(RoaringBitmap* r)
+{
+    size_t i;
+
+    for (i=0; i<r->n; ++i) {
+        RoaringContainer* c = &r->c[i];
+        const size_t runSize = dataSize(RC_RUN, countRuns(c));
+        const size_t plainSize = (c->card <= ROARING_ARRAY_MAX)
+                               ? dataSize(RC_ARRAY, c->card)
+                               : dataSize(RC_BITSET, 0);
+
+        if (runSize < plainSize) {
+            if (c->type != RC_RUN && !toRuns(c))
+                return false;
+        } else if (c->type == RC_RUN) {
+            if (!((c->card <= ROARING_ARRAY_MAX) ? toArray(c) : toBitset(c)))
+                return false;
+        }
+    }
+    return true;
+}
+
+
+/** Returns the memory in bytes that a compressed bitmap allocates. */
+size_t Roaring_sizeInBytes(const RoaringBitmap* r)
+{
+    size_t size = sizeof(*r) + r->cap * sizeof(RoaringContainer);
+    size_t i;
+
+    for (i=0; i<r->n; ++i)
+        size += dataSize(r->c[i].type, r->c[i].cap);
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+
+/** Replaces the bits of a compressed bitmap by the bits of a Bitmap.
+ * @param[out] r the compressed bitmap
+ * @param[in] src the dense bitmap; at most 2^32 bits
+ * @retval true if done.
+ * @retval false if out of memory; \a r may hold part of the bits.
+ */
+bool Roaring_fromBitmap(RoaringBitmap* r, const Bitmap* src)
+{
+    const uint64_t total = Bitmap_totalBits(src);
+    uint64_t begin;
+
+    ASSERT_OP (total, <=, ROARING_UNIVERSE);
+
+    Roaring_clearAllBits(r);
+    for (begin=0; begin<total; begin+=CHUNK_BITS) {
+        const uint64_t end = (begin + CHUNK_BITS < total)
+                           ? begin + CHUNK_BITS : total;
+        const size_t card = Bitmap_risenBitCountInRange(src, begin, end);
+        RoaringContainer* c;
+        Index i;
+
+        if (card == 0)
+            continue;
+        c = insertContainer(r, r->n, (uint16_t)(begin >> 16));
+        if (c == NULL || (card > ROARING_ARRAY_MAX && !toBitset(c)))
+            return false;
+        if (c->type == RC_BITSET) {
+            uint64_t* w = (uint64_t*)c->data;
+            const size_t at = begin / 8;
+            const size_t nBytes = (end - begin) / 8;
+            size_t k;
+
+            for (k=0; k<nBytes/8; ++k)
+                w[k] = load64le(src->a + at + 8*k);
+            if (nBytes % 8 != 0)
+                w[k] = loadPartial64le(src->a + at + 8*k, nBytes % 8);
+            c->card = (uint32_t)card;
+        } else {
+            for (i=begin; (i=Bitmap_findRisenBit(src, i, end))<end; ++i)
+                if (!addValue(c, (uint32_t)(i - begin)))
+                    return false;
+        }
+    }
+    return Roaring_optimize(r);
+}
+
+
+/** Replaces the bits of a Bitmap by the bits of a compressed bitmap.
+ * @param[in] r the compressed bitmap
+ * @param[out] tgt the dense bitmap
+ * @retval true if done.
+ * @retval false if some risen bits lie beyond \a tgt; they are dropped.
+ */
+bool Roaring_toBitmap(const RoaringBitmap* r, Bitmap* tgt)
+{
+    const uint64_t total = Bitmap_totalBits(tgt);
+    bool fit = true;
+    size_t i;
+
+    Bitmap_clearAllBits(tgt);
+    for (i=0; i<r->n; ++i) {
+        const RoaringContainer* c = &r->c[i];
+        const uint64_t base = (uint64_t)c->key << 16;
+        int32_t v;
+
+        for (v=nextValue(c, 0); v!=NONE; ) {
+            // sets a run of values at a time
+            uint32_t last = (uint32_t)v;
+            uint64_t end;
+
+            if (c->type == RC_RUN)
+                last = ((const RoaringRun*)c->data)
+                       [runLowerBound((const RoaringRun*)c->data, c->n, v)].last;
+            else if (c->type == RC_BITSET)
+                last = nextGap((const uint64_t*)c->data, (uint32_t)v) - 1;
+
+            end = base + last + 1;
+            if (end > total) {
+                fit = false;
+                end = total;
+            }
+            if (base + (uint32_t)v < end)
+                Bitmap_setRange(tgt, base + (uint32_t)v, end);
+            v = (last + 1 < CHUNK_BITS) ? nextValue(c, last + 1) : NONE;
+        }
+    }
+    return fit;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file Roaring.h
+ *      Interface of a compressed bitmap over the 32-bit universe, in the
+ *      manner of Roaring bitmaps.
+ *
+ *      The universe is split into chunks of 2^16 bits by the high 16 bits of
+ *      the index. Only non-empty chunks are kept, each in a container of the
+ *      kind that suits it:
+ *      - an \em array of sorted 16-bit values, for up to #ROARING_ARRAY_MAX
+ *        values;
+ *      - a \em bitset of 2^16 bits, for more values;
+ *      - \em runs of consecutive values, made by Roaring_optimize() where
+ *        they are the smallest.
+ *
+ *      So the memory grows with the number of risen bits (and runs), not
+ *      with the universe. A run container is turned back into an array or
+ *      a bitset when it is changed.
+ * @note Host only: the containers are allocated by malloc().
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see Roaring.c
+ * @see Roaring_test.c
+ */
+#ifndef _ROARING_H_
+#define _ROARING_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include "platform.h"
+#include "Bitmap.h"
+
+
+/// the number of bits of the universe
+#define ROARING_UNIVERSE    ((uint64_t)1 << 32)
+
+enum {
+    ROARING_ARRAY_MAX = 4096    ///< the most values of an array container
+};
+
+
+/// A run of values [start, last]
+typedef struct {
+    uint16_t start;
+    uint16_t last;
+} RoaringRun;
+
+
+/// A container of the values of one chunk
+typedef struct {
+    uint16_t key;       ///< the high 16 bits of the values
+    uint8_t type;       ///< array, bitset or runs
+    uint32_t card;      ///< the number of values
+    uint32_t n;         ///< the number of array values or runs
+    uint32_t cap;       ///< the allocated number of array values or runs
+    void* data;         ///< uint16_t[], uint64_t[1024] or RoaringRun[]
+} RoaringContainer;
+
+
+typedef struct {
+    RoaringContainer* c;    ///< the containers, in ascending key order
+    size_t n;               ///< the number of containers
+    size_t cap;             ///< the allocated number of containers
+} RoaringBitmap;
+
+
+void Roaring_init(RoaringBitmap*);
+void Roaring_destroy(RoaringBitmap*);
+void Roaring_clearAllBits(RoaringBitmap*);
+
+bool Roaring_setBit(RoaringBitmap*, uint32_t i);
+bool Roaring_clrBit(RoaringBitmap*, uint32_t i);
+Bit Roaring_getBit(const RoaringBitmap*, uint32_t i);
+
+uint64_t Roaring_risenBitCount(const RoaringBitmap*, uint64_t end);
+uint64_t Roaring_findRisenBit(const RoaringBitmap*, uint64_t begin, uint64_t end);
+uint64_t Roaring_findRisenBitRingedly(const RoaringBitmap*, uint64_t begin,
+                                      uint64_t end);
+
+bool Roaring_optimize(RoaringBitmap*);
+size_t Roaring_sizeInBytes(const RoaringBitmap*);
+
+bool Roaring_fromBitmap(RoaringBitmap*, const Bitmap* src);
+bool Roaring_toBitmap(const RoaringBitmap*, Bitmap* tgt);
+
+#endif // _ROARING_H_
+
+/** @example Roaring_test.c
+ *      This is an example of how to use the Roaring module.
+ */
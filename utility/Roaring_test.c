@@ -0,0 +1,118 @@
+/**
+ * @file Roaring_test.c
+ *      tests the compressed bitmap, and its conversions to and from Bitmap.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see Roaring.h
+ * @see Roaring.c
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "Roaring.h"
+#include "ToyUnit.h"
+
+enum {
+    DENSE_BYTES= 3 << 13,       ///< three chunks
+    DENSE_BITS= 8 * DENSE_BYTES
+};
+
+static Byte dense[DENSE_BYTES];
+static Byte dense2[DENSE_BYTES];
+
+
+int main()
+{
+    RoaringBitmap r;
+    Bitmap b, b2;
+    uint32_t i;
+    uint64_t n;
+
+    Roaring_init(&r);
+    TU_ASSERT("t1-1", Roaring_risenBitCount(&r, ROARING_UNIVERSE) == 0);
+    TU_ASSERT("t1-2", Roaring_findRisenBit(&r, 0, ROARING_UNIVERSE) == ROARING_UNIVERSE);
+    TU_ASSERT("t1-3", !Roaring_getBit(&r, 12345));
+
+    // sparse values over the whole 32-bit universe
+    TU_ASSERT("t2-1", Roaring_setBit(&r, 7));
+    TU_ASSERT("t2-2", Roaring_setBit(&r, 0x12345678));
+    TU_ASSERT("t2-3", Roaring_setBit(&r, 0xFFFFFFFF));
+    TU_ASSERT("t2-4", Roaring_setBit(&r, 7));       // again
+    TU_ASSERT("t2-5", r.n == 3);
+    TU_ASSERT("t2-6", Roaring_getBit(&r, 0x12345678));
+    TU_ASSERT("t2-7", !Roaring_getBit(&r, 0x12345679));
+    TU_ASSERT("t2-8", Roaring_risenBitCount(&r, ROARING_UNIVERSE) == 3);
+    TU_ASSERT("t2-9", Roaring_risenBitCount(&r, 0x12345678) == 1);
+    TU_ASSERT("t2-10", Roaring_risenBitCount(&r, 0x12345679) == 2);
+    TU_ASSERT("t2-11", Roaring_findRisenBit(&r, 8, ROARING_UNIVERSE) == 0x12345678);
+    TU_ASSERT("t2-12", Roaring_findRisenBit(&r, 8, 0x12345678) == 0x12345678);
+    TU_ASSERT("t2-13", Roaring_findRisenBit(&r, 0x12345679, ROARING_UNIVERSE) == 0xFFFFFFFF);
+    TU_ASSERT("t2-14", Roaring_findRisenBitRingedly(&r, 0x12345679, 0xFFFFFFFF) == 7);
+    TU_ASSERT("t2-15", Roaring_sizeInBytes(&r) < 256);
+
+    TU_ASSERT("t3-1", Roaring_clrBit(&r, 7));
+    TU_ASSERT("t3-2", Roaring_clrBit(&r, 7));       // again
+    TU_ASSERT("t3-3", r.n == 2);
+    TU_ASSERT("t3-4", Roaring_findRisenBitRingedly(&r, 0x12345679, 0xFFFFFFFF) == 0x12345678);
+    Roaring_clearAllBits(&r);
+    TU_ASSERT("t3-5", Roaring_findRisenBitRingedly(&r, 5, ROARING_UNIVERSE) == ROARING_UNIVERSE);
+
+    // an array container grows into a bitset, and shrinks back
+    for (i=0; i<2*ROARING_ARRAY_MAX; ++i)
+        Roaring_setBit(&r, 0x50000 + 3*i);
+    TU_ASSERT("t4-1", r.n == 1 && r.c[0].card == 2*ROARING_ARRAY_MAX);
+    TU_ASSERT("t4-2", Roaring_getBit(&r, 0x50000 + 3*100));
+    TU_ASSERT("t4-3", !Roaring_getBit(&r, 0x50000 + 3*100 + 1));
+    TU_ASSERT("t4-4", Roaring_findRisenBit(&r, 0x50001, ROARING_UNIVERSE) == 0x50003);
+    TU_ASSERT("t4-5", Roaring_risenBitCount(&r, 0x50000 + 3*1000) == 1000);
+    for (i=0; i<ROARING_ARRAY_MAX + 10; ++i)
+        Roaring_clrBit(&r, 0x50000 + 3*i);
+    TU_ASSERT("t4-6", Roaring_risenBitCount(&r, ROARING_UNIVERSE) == ROARING_ARRAY_MAX - 10);
+    TU_ASSERT("t4-7", Roaring_findRisenBit(&r, 0, ROARING_UNIVERSE)
+                      == 0x50000 + 3*(ROARING_ARRAY_MAX + 10));
+
+    // a long run is stored in a few bytes after optimizing
+    Roaring_clearAllBits(&r);
+    for (i=0x70000; i<0x70000 + 50000; ++i)
+        Roaring_setBit(&r, i);
+    TU_ASSERT("t5-1", Roaring_optimize(&r));
+    TU_ASSERT("t5-2", Roaring_sizeInBytes(&r) < 256);
+    TU_ASSERT("t5-3", Roaring_getBit(&r, 0x70000 + 49999));
+    TU_ASSERT("t5-4", !Roaring_getBit(&r, 0x70000 + 50000));
+    TU_ASSERT("t5-5", Roaring_risenBitCount(&r, 0x70000 + 100) == 100);
+    TU_ASSERT("t5-6", Roaring_findRisenBit(&r, 0x70010, ROARING_UNIVERSE) == 0x70010);
+    TU_ASSERT("t5-7", Roaring_clrBit(&r, 0x70000 + 20));    // splits the run
+    TU_ASSERT("t5-8", Roaring_findRisenBit(&r, 0x70014, ROARING_UNIVERSE) == 0x70015);
+    TU_ASSERT("t5-9", Roaring_risenBitCount(&r, ROARING_UNIVERSE) == 49999);
+    TU_ASSERT("t5-10", Roaring_optimize(&r));
+    TU_ASSERT("t5-11", Roaring_risenBitCount(&r, ROARING_UNIVERSE) == 49999);
+
+    // to and from the dense Bitmap: runs, a bitset and an array chunk
+    Bitmap_init(&b, dense, DENSE_BYTES);
+    Bitmap_init(&b2, dense2, DENSE_BYTES);
+    Bitmap_setRange(&b, 100, 30000);
+    for (i=0; i<40000; ++i)
+        Bitmap_setBit(&b, 65536 + (i * 7919) % 65536);
+    Bitmap_setBit(&b, 2*65536 + 5);
+    Bitmap_setBit(&b, DENSE_BITS-1);
+    n = Bitmap_risenBitCount(&b, DENSE_BITS);
+    TU_ASSERT("t6-1", Roaring_fromBitmap(&r, &b));
+    TU_ASSERT("t6-2", r.n == 3);
+    TU_ASSERT("t6-3", Roaring_risenBitCount(&r, ROARING_UNIVERSE) == n);
+    TU_ASSERT("t6-4", Roaring_findRisenBit(&r, 30000, ROARING_UNIVERSE)
+                      == Bitmap_findRisenBit(&b, 30000, DENSE_BITS));
+    TU_ASSERT("t6-5", Roaring_findRisenBit(&r, 2*65536, ROARING_UNIVERSE) == 2*65536 + 5);
+    TU_ASSERT("t6-6", Roaring_toBitmap(&r, &b2));
+    TU_ASSERT("t6-7", memcmp(dense, dense2, DENSE_BYTES) == 0);
+
+    Roaring_setBit(&r, DENSE_BITS);     // beyond the dense bitmap
+    TU_ASSERT("t6-8", !Roaring_toBitmap(&r, &b2));
+    TU_ASSERT("t6-9", memcmp(dense, dense2, DENSE_BYTES) == 0);
+
+    Roaring_destroy(&r);
+    TU_ASSERT("t7-1", r.n == 0 && r.c == NULL);
+
+    TU_RESULT();
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file SPSCQueue.c
+ *      Implements a lock-free single-producer/single-consumer queue, and
+ *      that uses a circular array with separate head and tail indices.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see SPSCQueue.h
+ * @see SPSCQueue_test.c
+ */
+#include "SPSCQueue.h"
+#include "assertions.h"
+
+
+/// Returns the index next to \a i in a queue.
+#define NEXT(q, i)  (((i) + 1 == (q)->buf_size) ? 0 : (i) + 1)
+
+
+/** Initilizes a queue. This must be done before the producer and the
+ *      consumer start.
+ * @param[out] q the queue to be initialized.
+ * @param[in] buf the buffer to store items.
+ * @param[in] buf_size the buffer size; the queue holds \a buf_size-1 items.
+ *      It must fit in an #SQIndex, e.g. at most 255 with \c Idx8.
+ */
+void SQ_init( SPSCQueue* q, QueueItem* buf, size_t buf_size )
+{
+    ASSERT_OP (buf_size, >=, 2);
+    ASSERT_OP (buf_size, <=, (SQIndex)-1);
+
+    q->buf= buf;
+    q->buf_size= buf_size;
+    SQ_STORE(&q->tail, 0, relaxed);
+    SQ_STORE(&q->head, 0, relaxed);
+    q->cachedHead= 0;
+    q->cachedTail= 0;
+}
+
+
+/** Puts an item to the end of a queue. Called by the producer only.
+ * @param[in,out] q the queue to add an item.
+ * @param[in] i the added item.
+ * @retval true if the item is put.
+ * @retval false if the queue is full.
+ */
+bool SQ_put( SPSCQueue* q, QueueItem i )
+{
+    const SQIndex tail= SQ_LOAD(&q->tail, relaxed);
+    const SQIndex next= NEXT(q, tail);
+
+    if (next == q->cachedHead) {
+        q->cachedHead= SQ_LOAD(&q->head, acquire);
+        if (next == q->cachedHead)
+            return false;
+    }
+    SQ_SLOT(q, tail)= i;
+    SQ_STORE(&q->tail, next, release);
+    return true;
+}
+
+
+/** Gets the first item of a queue. Called by the consumer only.
+ * @param[in,out] q the queue to get an item.
+ * @param[out] i the gotten item.
+ * @retval true if an item is gotten.
+ * @retval false if the queue is empty.
+ */
+bool SQ_get( SPSCQueue* q, QueueItem* i )
+{
+    const SQIndex head= SQ_LOAD(&q->head, relaxed);
+
+    if (head == q->cachedTail) {
+        q->cachedTail= SQ_LOAD(&q->tail, acquire);
+        if (head == q->cachedTail)
+            return false;
+    }
+    *i= SQ_SLOT(q, head);
+    SQ_STORE(&q->head, NEXT(q, head), release);
+    return true;
+}
+
+
+/** Returns the maximum number of items a queue can hold. */
+size_t SQ_capacity( const SPSCQueue* q )
+{
+    return q->buf_size - 1;
+}
+
+
+/** Gets the size of a queue at the moment.
+ * The result is only a snapshot if the other side is running.
+ */
+size_t SQ_size( const SPSCQueue* q )
+{
+    const SQIndex head= SQ_LOAD(&q->head, acquire);
+    const SQIndex tail= SQ_LOAD(&q->tail, acquire);
+
+    return (tail >= head) ? tail - head : q->buf_size - head + tail;
+}
+
+
+/** Determines if a queue is empty. */
+bool SQ_empty( const SPSCQueue* q )
+{
+    return SQ_LOAD(&q->head, acquire) == SQ_LOAD(&q->tail, acquire);
+}
+
+
+/** Determines if a queue is full. */
+bool SQ_full( const SPSCQueue* q )
+{
+    const SQIndex tail= SQ_LOAD(&q->tail, acquire);
+
+    return NEXT(q, tail) == SQ_LOAD(&q->head, acquire);
+}
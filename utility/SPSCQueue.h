@@ -0,0 +1,109 @@
+/**
+ * @file SPSCQueue.h
+ *      Interface of a lock-free single-producer/single-consumer queue.
+ *
+ *      The producer only writes \c tail and the consumer only writes \c head,
+ *      so one producer and one consumer (e.g. an ISR and the main loop, or
+ *      two threads) may run concurrently without interrupt masking or mutex.
+ *      There is no shared \c count; one slot of the buffer is kept empty to
+ *      tell a full queue from an empty one.
+ * @attention Without C11 atomics, GCC and Clang use their \c __atomic
+ *      builtins with the same ordering. Other compilers fall back to
+ *      \c volatile indices and slots, which the compiler keeps in program
+ *      order but the CPU may not: that is enough for an ISR and the main
+ *      loop on one in-order core (e.g. an 8051), not for threads on a
+ *      multi-core host. It is also safe only if the CPU reads and writes
+ *      an #SQIndex in one instruction; on 8-bit targets define
+ *      \c SQ_INDEX_TYPE to \c Idx8 (buffers up to 255 items).
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see SPSCQueue.c
+ * @see SPSCQueue_test.c
+ */
+#ifndef _SPSC_QUEUE_H_
+#define _SPSC_QUEUE_H_
+
+
+#include <stddef.h>
+#include "platform.h"
+#include "Queue.h"
+
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) \
+        && !defined(__STDC_NO_ATOMICS__)
+    #include <stdatomic.h>
+
+    #define SQ_ATOMIC(T)            _Atomic T
+    #define SQ_LOAD(p, order)       \
+        atomic_load_explicit(p, memory_order_##order)
+    #define SQ_STORE(p, v, order)   \
+        atomic_store_explicit(p, v, memory_order_##order)
+
+    /// Keeps producer-side and consumer-side fields on separate cache lines
+    #define SQ_CACHE_ALIGNED        _Alignas(SQ_CACHE_LINE_SIZE)
+
+    /// Returns the slot \a i of the buffer of a queue.
+    #define SQ_SLOT(q, i)           ((q)->buf[i])
+#elif defined(__GNUC__)
+    #define SQ_ORDER_relaxed        __ATOMIC_RELAXED
+    #define SQ_ORDER_acquire        __ATOMIC_ACQUIRE
+    #define SQ_ORDER_release        __ATOMIC_RELEASE
+
+    #define SQ_ATOMIC(T)            T
+    #define SQ_LOAD(p, order)       __atomic_load_n(p, SQ_ORDER_##order)
+    #define SQ_STORE(p, v, order)   __atomic_store_n(p, v, SQ_ORDER_##order)
+    #define SQ_CACHE_ALIGNED        \
+        __attribute__((aligned(SQ_CACHE_LINE_SIZE)))
+    #define SQ_SLOT(q, i)           ((q)->buf[i])
+#else
+    #define SQ_ATOMIC(T)            volatile T
+    #define SQ_LOAD(p, order)       (*(p))
+    #define SQ_STORE(p, v, order)   (*(p) = (v))
+    #define SQ_CACHE_ALIGNED
+
+    /// The slots are volatile too, so that the compiler cannot move the
+    /// store of an item past the store of the index that publishes it.
+    #define SQ_SLOT(q, i)           (((volatile QueueItem*)(q)->buf)[i])
+#endif
+
+#ifndef SQ_CACHE_LINE_SIZE
+    #define SQ_CACHE_LINE_SIZE  64  ///< cache line size of the host CPU
+#endif
+
+#ifndef SQ_INDEX_TYPE
+    #define SQ_INDEX_TYPE   size_t  ///< type of the head and tail indices
+#endif
+
+typedef SQ_INDEX_TYPE SQIndex;  ///< index type of a SPSC queue
+
+
+typedef struct {
+    QueueItem* buf;     ///< a pointer that indicates the buffer of a queue.
+    SQIndex buf_size;   ///< buffer size.
+
+    /// index of the end (last+1) of a queue; written by the producer only.
+    SQ_CACHE_ALIGNED SQ_ATOMIC(SQIndex) tail;
+    SQIndex cachedHead; ///< producer's last seen \c head.
+
+    /// index of the first item of a queue; written by the consumer only.
+    SQ_CACHE_ALIGNED SQ_ATOMIC(SQIndex) head;
+    SQIndex cachedTail; ///< consumer's last seen \c tail.
+} SPSCQueue;
+
+
+void SQ_init( SPSCQueue* q, QueueItem* buf, size_t buf_size );
+
+bool SQ_put( SPSCQueue*, QueueItem );
+bool SQ_get( SPSCQueue*, QueueItem* );
+
+size_t SQ_capacity( const SPSCQueue* );
+size_t SQ_size( const SPSCQueue* );
+bool SQ_empty( const SPSCQueue* );
+bool SQ_full( const SPSCQueue* );
+
+#endif // _SPSC_QUEUE_H_
+
+/** @example SPSCQueue_test.c
+ *      This is an example of how to use the SPSCQueue module.
+ */
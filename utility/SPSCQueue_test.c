@@ -0,0 +1,122 @@
+/**
+ * @file SPSCQueue_test.c
+ *      tests the SPSC queue, and measures its two-thread throughput.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see SPSCQueue.h
+ * @see SPSCQueue.c
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "SPSCQueue.h"
+#include "ToyUnit.h"
+
+enum {
+    BUF_SIZE= 4,
+    MT_BUF_SIZE= 1024,
+    MT_ITEMS= 4000000   ///< items passed from the producer to the consumer
+};
+
+char buf[BUF_SIZE];
+char mtBuf[MT_BUF_SIZE];
+
+static SPSCQueue mtQueue;
+static unsigned long mtErrors;
+
+
+/** Puts a sequence of items (the low bits of a counter). */
+static void* producer( void* arg )
+{
+    unsigned long n;
+
+    (void)arg;
+    for (n=0; n<MT_ITEMS; ++n) {
+        while (!SQ_put(&mtQueue, (QueueItem)(n & 0x7F)))
+            sched_yield();
+    }
+    return NULL;
+}
+
+
+/** Gets the sequence back and counts out-of-order items. */
+static void* consumer( void* arg )
+{
+    unsigned long n;
+    QueueItem i;
+
+    (void)arg;
+    for (n=0; n<MT_ITEMS; ++n) {
+        while (!SQ_get(&mtQueue, &i))
+            sched_yield();
+        if (i != (QueueItem)(n & 0x7F))
+            ++mtErrors;
+    }
+    return NULL;
+}
+
+
+static double now( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+int main()
+{
+    SPSCQueue q;
+    QueueItem i;
+    pthread_t tp, tc;
+    double t0, t1;
+
+    SQ_init( &q, buf, BUF_SIZE );
+    TU_ASSERT("03", SQ_empty(&q));
+    TU_ASSERT("04", !SQ_full(&q));
+    TU_ASSERT("05", SQ_size(&q) == 0);
+    TU_ASSERT("06", SQ_capacity(&q) == BUF_SIZE-1);
+    TU_ASSERT("07", !SQ_get(&q, &i));
+
+    TU_ASSERT("11", SQ_put(&q, 'a'));
+    TU_ASSERT("12", SQ_put(&q, 'b'));
+    TU_ASSERT("13", SQ_put(&q, 'c'));
+    TU_ASSERT("14", SQ_full(&q));
+    TU_ASSERT("15", SQ_size(&q) == 3);
+    TU_ASSERT("16", !SQ_put(&q, 'd'));
+
+    TU_ASSERT("21", SQ_get(&q, &i) && i == 'a');
+    TU_ASSERT("22", !SQ_full(&q));
+    TU_ASSERT("23", SQ_size(&q) == 2);
+    TU_ASSERT("24", SQ_put(&q, 'd'));   // wraps around
+    TU_ASSERT("25", SQ_size(&q) == 3);
+
+    TU_ASSERT("31", SQ_get(&q, &i) && i == 'b');
+    TU_ASSERT("32", SQ_get(&q, &i) && i == 'c');
+    TU_ASSERT("33", SQ_get(&q, &i) && i == 'd');
+    TU_ASSERT("34", SQ_empty(&q));
+    TU_ASSERT("35", SQ_size(&q) == 0);
+    TU_ASSERT("36", !SQ_get(&q, &i));
+
+    // two-thread throughput
+    SQ_init( &mtQueue, mtBuf, MT_BUF_SIZE );
+    t0= now();
+    pthread_create(&tc, NULL, consumer, NULL);
+    pthread_create(&tp, NULL, producer, NULL);
+    pthread_join(tp, NULL);
+    pthread_join(tc, NULL);
+    t1= now();
+    TU_ASSERT("41", mtErrors == 0);
+    TU_ASSERT("42", SQ_empty(&mtQueue));
+    printf("\n%d items in %.3f s: %.1f Mitems/s",
+           MT_ITEMS, t1 - t0, MT_ITEMS / (t1 - t0) / 1e6);
+
+    TU_RESULT();
+
+    return 0;
+}
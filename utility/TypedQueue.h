@@ -0,0 +1,133 @@
+/**
+ * @file TypedQueue.h
+ *      Generates type-generic queues with embedded storage.
+ *
+ *      DECLARE_QUEUE(name, type, capacity) declares a queue type \a name
+ *      holding up to \a capacity items of \a type, and its operations
+ *      \a name_init(), \a name_put(), \a name_get(), ... in the manner of
+ *      the Queue module. The storage is a member of the queue and the
+ *      capacity is a compile-time constant, so the wrap arithmetic is
+ *      constant-folded (a mask for power-of-two capacities) and no pointer
+ *      to the buffer is chased.
+ *
+ *      The functions are \c static \c inline, or plain \c static on Keil
+ *      C51, which has no \c inline (see #TQ_INLINE). Define
+ *      \c TQ_INDEX_TYPE to \c Idx8 for 8-bit indices on 8-bit targets.
+ * @code
+ * DECLARE_QUEUE(TaskQueue, uint8_t, 16);
+ *
+ * static TaskQueue tasks;
+ * TaskQueue_init(&tasks);
+ * TaskQueue_put(&tasks, 3);
+ * @endcode
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see Queue.h
+ * @see TypedQueue_test.c
+ */
+#ifndef _TYPED_QUEUE_H_
+#define _TYPED_QUEUE_H_
+
+
+#include <assert.h>
+#include <stddef.h>
+#include "platform.h"
+
+
+#ifndef TQ_INDEX_TYPE
+    #define TQ_INDEX_TYPE   size_t  ///< type of the first and count indices
+#endif
+
+typedef TQ_INDEX_TYPE TQIndex;  ///< index type of a typed queue
+
+
+/** Declares a queue type \a name of \a capacity items of \a type.
+ * @param name the name of the queue type; also the prefix of its operations.
+ * @param type the item type.
+ * @param capacity the maximum number of items; a constant expression
+ *      that fits in a #TQIndex.
+ */
+#define DECLARE_QUEUE(name, type, capacity)                                 \
+    typedef struct {                                                        \
+        TQIndex first;          /* index of the first (front) item */       \
+        TQIndex count;          /* the number of items */                   \
+        type buf[capacity];     /* the embedded buffer */                   \
+    } name;                                                                 \
+                                                                            \
+    /* fails to compile if the capacity does not fit in a TQIndex */        \
+    typedef char name##_fits_[((capacity) <= (TQIndex)-1) ? 1 : -1];        \
+                                                                            \
+    TQ_INLINE void name##_init( name* q )                                   \
+    {                                                                       \
+        q->first= 0;                                                        \
+        q->count= 0;                                                        \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE void name##_clear( name* q )                                  \
+    {                                                                       \
+        q->first= 0;                                                        \
+        q->count= 0;                                                        \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE size_t name##_capacity( void )                                \
+    {                                                                       \
+        return (capacity);                                                  \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE size_t name##_size( const name* q )                           \
+    {                                                                       \
+        return q->count;                                                    \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE bool name##_empty( const name* q )                            \
+    {                                                                       \
+        return q->count == 0;                                               \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE bool name##_full( const name* q )                             \
+    {                                                                       \
+        return q->count == (capacity);                                      \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE void name##_put( name* q, type i )                            \
+    {                                                                       \
+        assert (!name##_full(q));                                           \
+                                                                            \
+        q->buf[(q->first + q->count) % (capacity)]= i;                      \
+        ++q->count;                                                         \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE type name##_get( name* q )                                    \
+    {                                                                       \
+        type i;                                                             \
+        assert (!name##_empty(q));                                          \
+                                                                            \
+        i= q->buf[q->first];                                                \
+        q->first= (q->first + 1) % (capacity);                              \
+        --q->count;                                                         \
+        return i;                                                           \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE type name##_first( const name* q )                            \
+    {                                                                       \
+        assert (!name##_empty(q));                                          \
+                                                                            \
+        return q->buf[q->first];                                            \
+    }                                                                       \
+                                                                            \
+    TQ_INLINE type name##_last( const name* q )                             \
+    {                                                                       \
+        assert (!name##_empty(q));                                          \
+                                                                            \
+        return q->buf[(q->first + q->count - 1) % (capacity)];              \
+    }                                                                       \
+                                                                            \
+    typedef int name##_declared_ /* swallows the trailing semicolon */
+
+
+#endif // _TYPED_QUEUE_H_
+
+/** @example TypedQueue_test.c
+ *      This is an example of how to use the TypedQueue generator.
+ */
@@ -0,0 +1,69 @@
+/**
+ * @file TypedQueue_test.c
+ *      tests the queues generated by DECLARE_QUEUE().
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see TypedQueue.h
+ */
+#include "TypedQueue.h"
+#include "ToyUnit.h"
+
+typedef struct {
+    uint8_t id;
+    uint16_t stamp;
+} Message;
+
+DECLARE_QUEUE(TaskQueue, uint8_t, 3);
+DECLARE_QUEUE(MessageQueue, Message, 4);
+
+
+int main()
+{
+    TaskQueue q;
+    MessageQueue mq;
+    Message m;
+
+    TaskQueue_init( &q );
+    TU_ASSERT("03", TaskQueue_empty(&q));
+    TU_ASSERT("04", !TaskQueue_full(&q));
+    TU_ASSERT("05", TaskQueue_size(&q) == 0);
+    TU_ASSERT("06", TaskQueue_capacity() == 3);
+
+    TaskQueue_put(&q, 1);
+    TaskQueue_put(&q, 2);
+    TaskQueue_put(&q, 3);
+    TU_ASSERT("12", TaskQueue_first(&q) == 1);
+    TU_ASSERT("13", TaskQueue_last(&q) == 3);
+    TU_ASSERT("14", TaskQueue_full(&q));
+    TU_ASSERT("15", TaskQueue_size(&q) == 3);
+
+    TU_ASSERT("21", TaskQueue_get(&q) == 1);
+    TaskQueue_put(&q, 4);   // wraps around
+    TU_ASSERT("22", TaskQueue_last(&q) == 4);
+    TU_ASSERT("23", TaskQueue_get(&q) == 2);
+    TU_ASSERT("24", TaskQueue_get(&q) == 3);
+    TU_ASSERT("25", TaskQueue_get(&q) == 4);
+    TU_ASSERT("26", TaskQueue_empty(&q));
+
+    TaskQueue_put(&q, 5);
+    TaskQueue_clear(&q);
+    TU_ASSERT("31", TaskQueue_empty(&q));
+
+    MessageQueue_init( &mq );
+    TU_ASSERT("41", MessageQueue_capacity() == 4);
+    m.id= 7;
+    m.stamp= 1000;
+    MessageQueue_put(&mq, m);
+    m.id= 8;
+    m.stamp= 2000;
+    MessageQueue_put(&mq, m);
+    TU_ASSERT("42", MessageQueue_size(&mq) == 2);
+    TU_ASSERT("43", MessageQueue_last(&mq).stamp == 2000);
+    m= MessageQueue_get(&mq);
+    TU_ASSERT("44", m.id == 7 && m.stamp == 1000);
+    TU_ASSERT("45", MessageQueue_first(&mq).id == 8);
+
+    TU_RESULT();
+
+    return 0;
+}
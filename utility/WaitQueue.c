@@ -0,0 +1,223 @@
+/**
+ * @file WaitQueue.c
+ *      Implements a waitable queue with a mutex and eventfds.
+ *
+ *      Invariant (under the lock): \c readFd is readable if and only if the
+ *      queue is not empty, and \c writeFd if and only if it is not full.
+ *      The eventfds are only touched when that state flips.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see WaitQueue.h
+ * @see WaitQueue_test.c
+ */
+#define _GNU_SOURCE
+
+#include <poll.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "WaitQueue.h"
+
+
+/** Makes eventfd \a fd readable, and counts it as a wake-up. */
+static void setReady( WaitQueue* q, int fd )
+{
+    uint64_t one= 1;
+
+    if (write(fd, &one, sizeof(one)) == sizeof(one))
+        ++q->wakeups;
+}
+
+
+/** Makes eventfd \a fd unreadable. */
+static void clearReady( int fd )
+{
+    uint64_t value;
+
+    if (read(fd, &value, sizeof(value)) != sizeof(value))
+        return;     // already unreadable
+}
+
+
+/** Returns the monotonic time in milliseconds. */
+static long long nowMs( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+}
+
+
+/** Waits, with the lock released, until \a fd is readable or \a deadline.
+ * @retval true if \a fd got readable (the state is to be checked again).
+ * @retval false on timeout.
+ */
+static bool waitFor( WaitQueue* q, int fd, int timeout_ms, long long deadline )
+{
+    struct pollfd pfd;
+    int ms= timeout_ms;
+    int rc;
+
+    if (timeout_ms != WQ_FOREVER) {
+        long long left= deadline - nowMs();
+
+        if (left <= 0)
+            return false;
+        ms= (int)left;
+    }
+
+    pfd.fd= fd;
+    pfd.events= POLLIN;
+    pthread_mutex_unlock(&q->lock);
+    rc= poll(&pfd, 1, ms);
+    pthread_mutex_lock(&q->lock);
+    return rc != 0 || timeout_ms == WQ_FOREVER;
+}
+
+
+/** Initilizes a queue.
+ * @param[out] q the queue to be initialized.
+ * @param[in] buf the buffer to store items.
+ * @param[in] buf_size the buffer size.
+ * @retval true on success.
+ * @retval false if the eventfds cannot be created.
+ */
+bool WQ_init( WaitQueue* q, QueueItem* buf, size_t buf_size )
+{
+    Q_init(&q->q, buf, buf_size);
+    q->wakeups= 0;
+    q->readFd= eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    q->writeFd= eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC);    // has room
+    if (q->readFd < 0 || q->writeFd < 0) {
+        if (q->readFd >= 0)
+            close(q->readFd);
+        if (q->writeFd >= 0)
+            close(q->writeFd);
+        return false;
+    }
+    pthread_mutex_init(&q->lock, NULL);
+    return true;
+}
+
+
+/** Releases the eventfds and the mutex of a queue. */
+void WQ_destroy( WaitQueue* q )
+{
+    close(q->readFd);
+    close(q->writeFd);
+    pthread_mutex_destroy(&q->lock);
+}
+
+
+/** Puts up to \a n items, waiting for room as needed.
+ * Consumers are woken once per call at most, when the queue turns
+ * non-empty.
+ * @param[in,out] q the queue to add items.
+ * @param[in] items the added items.
+ * @param[in] n the number of items to add.
+ * @param[in] timeout_ms the time limit; 0 not to wait, #WQ_FOREVER for no
+ *      limit.
+ * @return the number of items put; less than \a n on timeout.
+ */
+size_t WQ_putN( WaitQueue* q, const QueueItem* items, size_t n,
+                int timeout_ms )
+{
+    const long long deadline= nowMs() + timeout_ms;
+    size_t done= 0;
+
+    pthread_mutex_lock(&q->lock);
+    while (done < n) {
+        bool wasEmpty= Q_empty(&q->q);
+        size_t moved= Q_putN(&q->q, items + done, n - done);
+
+        if (moved > 0) {
+            done += moved;
+            if (wasEmpty)
+                setReady(q, q->readFd);
+            if (Q_full(&q->q))
+                clearReady(q->writeFd);
+        }
+        if (done < n && !waitFor(q, q->writeFd, timeout_ms, deadline))
+            break;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return done;
+}
+
+
+/** Gets up to \a n items, waiting until at least one is available.
+ * @param[in,out] q the queue to get items.
+ * @param[out] items the gotten items.
+ * @param[in] n the maximum number of items to get.
+ * @param[in] timeout_ms the time limit; 0 not to wait, #WQ_FOREVER for no
+ *      limit.
+ * @return the number of items gotten; 0 on timeout.
+ */
+size_t WQ_getN( WaitQueue* q, QueueItem* items, size_t n, int timeout_ms )
+{
+    const long long deadline= nowMs() + timeout_ms;
+    size_t moved= 0;
+
+    pthread_mutex_lock(&q->lock);
+    for (;;) {
+        bool wasFull= Q_full(&q->q);
+
+        moved= Q_getN(&q->q, items, n);
+        if (moved > 0) {
+            if (wasFull)
+                setReady(q, q->writeFd);
+            if (Q_empty(&q->q))
+                clearReady(q->readFd);
+            break;
+        }
+        if (n == 0 || !waitFor(q, q->readFd, timeout_ms, deadline))
+            break;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return moved;
+}
+
+
+/** Puts an item, waiting for room up to \a timeout_ms.
+ * @retval true if the item is put.
+ * @retval false on timeout.
+ */
+bool WQ_put( WaitQueue* q, QueueItem i, int timeout_ms )
+{
+    return WQ_putN(q, &i, 1, timeout_ms) == 1;
+}
+
+
+/** Gets an item, waiting for one up to \a timeout_ms.
+ * @retval true if an item is gotten.
+ * @retval false on timeout.
+ */
+bool WQ_get( WaitQueue* q, QueueItem* i, int timeout_ms )
+{
+    return WQ_getN(q, i, 1, timeout_ms) == 1;
+}
+
+
+/** Returns a file descriptor that polls readable (POLLIN/EPOLLIN) while
+ *  the queue holds items. Do not read or write it.
+ */
+int WQ_fd( const WaitQueue* q )
+{
+    return q->readFd;
+}
+
+
+/** Gets the size of a queue at the moment. */
+size_t WQ_size( WaitQueue* q )
+{
+    size_t n;
+
+    pthread_mutex_lock(&q->lock);
+    n= Q_size(&q->q);
+    pthread_mutex_unlock(&q->lock);
+    return n;
+}
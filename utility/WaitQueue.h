@@ -0,0 +1,58 @@
+/**
+ * @file WaitQueue.h
+ *      Interface of a waitable queue for host threads.
+ *
+ *      It wraps a Queue with a mutex and two eventfds: one is readable
+ *      while the queue holds items, the other while it has room. Blocking
+ *      and timed puts and gets sleep in poll(2) instead of spinning, and
+ *      WQ_fd() can be registered with an epoll loop. A wake-up is signalled
+ *      only when the queue turns non-empty (or non-full), so a producer
+ *      that puts 100 items wakes the consumers once, not 100 times.
+ * @note Linux only (eventfd).
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ * @see WaitQueue.c
+ * @see WaitQueue_test.c
+ */
+#ifndef _WAIT_QUEUE_H_
+#define _WAIT_QUEUE_H_
+
+
+#include <pthread.h>
+#include <stddef.h>
+#include "platform.h"
+#include "Queue.h"
+
+
+enum {
+    WQ_FOREVER= -1  ///< timeout value to wait without limit
+};
+
+typedef struct {
+    Queue q;                ///< the wrapped queue.
+    pthread_mutex_t lock;   ///< guards \c q.
+    int readFd;             ///< eventfd readable while \c q is not empty.
+    int writeFd;            ///< eventfd readable while \c q is not full.
+    unsigned long wakeups;  ///< the number of wake-ups signalled.
+} WaitQueue;
+
+
+bool WQ_init( WaitQueue* q, QueueItem* buf, size_t buf_size );
+void WQ_destroy( WaitQueue* );
+
+bool WQ_put( WaitQueue*, QueueItem, int timeout_ms );
+bool WQ_get( WaitQueue*, QueueItem*, int timeout_ms );
+
+size_t WQ_putN( WaitQueue*, const QueueItem* items, size_t n,
+                int timeout_ms );
+size_t WQ_getN( WaitQueue*, QueueItem* items, size_t n, int timeout_ms );
+
+int WQ_fd( const WaitQueue* );
+size_t WQ_size( WaitQueue* );
+
+#endif // _WAIT_QUEUE_H_
+
+/** @example WaitQueue_test.c
+ *      This is an example of how to use the WaitQueue module.
+ */
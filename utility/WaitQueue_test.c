@@ -0,0 +1,107 @@
+/**
+ * @file WaitQueue_test.c
+ *      tests the waitable queue.
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @see WaitQueue.h
+ * @see WaitQueue.c
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <poll.h>
+#include <string.h>
+#include <time.h>
+
+#include "WaitQueue.h"
+#include "ToyUnit.h"
+
+enum {
+    BUF_SIZE= 128,
+    BATCH= 100
+};
+
+char buf[BUF_SIZE];
+
+static WaitQueue wq;
+
+
+/** Puts a batch of items after the consumer has gone to sleep. */
+static void* producer( void* arg )
+{
+    char items[BATCH];
+    struct timespec nap= {0, 20000000};
+
+    (void)arg;
+    memset(items, 'x', sizeof(items));
+    nanosleep(&nap, NULL);
+    WQ_putN(&wq, items, BATCH, WQ_FOREVER);
+    return NULL;
+}
+
+
+/** Tells whether \a fd polls readable now. */
+static bool readable( int fd )
+{
+    struct pollfd pfd;
+
+    pfd.fd= fd;
+    pfd.events= POLLIN;
+    return poll(&pfd, 1, 0) == 1;
+}
+
+
+static double now( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+int main()
+{
+    QueueItem i;
+    char items[BUF_SIZE];
+    pthread_t tp;
+    double t0;
+    size_t n;
+
+    TU_ASSERT("01", WQ_init(&wq, buf, BUF_SIZE));
+    TU_ASSERT("02", WQ_size(&wq) == 0);
+    TU_ASSERT("03", !readable(WQ_fd(&wq)));
+    TU_ASSERT("04", !WQ_get(&wq, &i, 0));
+
+    t0= now();
+    TU_ASSERT("11", !WQ_get(&wq, &i, 30));
+    TU_ASSERT("12", now() - t0 >= 0.025);
+
+    TU_ASSERT("21", WQ_put(&wq, 'a', 0));
+    TU_ASSERT("22", readable(WQ_fd(&wq)));
+    TU_ASSERT("23", WQ_put(&wq, 'b', 0));
+    TU_ASSERT("24", wq.wakeups == 1);       // only on turning non-empty
+    TU_ASSERT("25", WQ_get(&wq, &i, 0) && i == 'a');
+    TU_ASSERT("26", readable(WQ_fd(&wq)));
+    TU_ASSERT("27", WQ_get(&wq, &i, WQ_FOREVER) && i == 'b');
+    TU_ASSERT("28", !readable(WQ_fd(&wq)));
+
+    // a full queue times out a put
+    TU_ASSERT("31", WQ_putN(&wq, items, BUF_SIZE, 0) == BUF_SIZE);
+    TU_ASSERT("32", !WQ_put(&wq, 'c', 10));
+    TU_ASSERT("33", WQ_getN(&wq, items, BUF_SIZE, 0) == BUF_SIZE);
+
+    // a blocked consumer is woken once for a batch
+    wq.wakeups= 0;
+    pthread_create(&tp, NULL, producer, NULL);
+    n= WQ_getN(&wq, items, BUF_SIZE, WQ_FOREVER);
+    pthread_join(tp, NULL);
+    n += WQ_getN(&wq, items, BUF_SIZE, 0);
+    TU_ASSERT("41", n == BATCH);
+    TU_ASSERT("42", wq.wakeups == 1);
+
+    WQ_destroy(&wq);
+
+    TU_RESULT();
+
+    return 0;
+}
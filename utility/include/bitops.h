@@ -0,0 +1,111 @@
+/**
+ * @file bitops.h
+ *      Word-at-a-time bit operations on 64-bit words.
+ *
+ *      The GCC/Clang builtins compile to the hardware instructions
+ *      (e.g. POPCNT, TZCNT) when the target has them; elsewhere portable
+ *      SWAR fallbacks are used.
+ * @note Defined only where uint64_t exists (not on Keil C51).
+ * @author agent, agent@local
+ * @date 2026/10/17 (initial)
+ * @version 1.0
+ */
+#ifndef _BITOPS_H
+#define _BITOPS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(UINT64_MAX)
+
+//------------------------------------------------------------------------------
+
+/// Returns a mask of the lowest \a n bits (0 <= n <= 64).
+#define LOW_MASK64(n)   (((n) >= 64) ? ~(uint64_t)0 : ((uint64_t)1 << (n)) - 1)
+
+
+/** Returns the number of set bits of \a x. */
+static inline unsigned popcount64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (unsigned)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+
+/** Returns the index of the lowest set bit of \a x; \a x must not be 0. */
+static inline unsigned ctz64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    return popcount64((x & (~x + 1)) - 1);
+#endif
+}
+
+
+/** Returns the index of the highest set bit of \a x; \a x must not be 0. */
+static inline unsigned msb64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return 63 - (unsigned)__builtin_clzll(x);
+#else
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    x |= x >> 32;
+    return popcount64(x) - 1;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+/** Loads 8 bytes as a little-endian word, so that bit \em i of the word is
+ *  bit (\em i % 8) of byte (\em i / 8). No alignment is required.
+ */
+static inline uint64_t load64le(const uint8_t* p)
+{
+    uint64_t w;
+
+    memcpy(&w, p, sizeof(w));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    w = __builtin_bswap64(w);
+#endif
+    return w;
+}
+
+
+/** Stores a word as 8 little-endian bytes; the inverse of load64le(). */
+static inline void store64le(uint8_t* p, uint64_t w)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    w = __builtin_bswap64(w);
+#endif
+    memcpy(p, &w, sizeof(w));
+}
+
+
+/** Loads \a n (< 8) bytes as a little-endian word; the rest is zero. */
+static inline uint64_t loadPartial64le(const uint8_t* p, size_t n)
+{
+    uint64_t w = 0;
+    size_t i;
+
+    for (i=0; i<n; ++i)
+        w |= (uint64_t)p[i] << (8*i);
+    return w;
+}
+
+//------------------------------------------------------------------------------
+
+#endif // UINT64_MAX
+
+#endif // _BITOPS_H
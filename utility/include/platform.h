@@ -3,8 +3,8 @@
  *      This header file provides \em platform-dependent declaration
  * @author Jiang Yu-Kuan, yukuan.jiang@gmail.com
  * @date 2005/3/13 (initial)
- * @date 2005/10/18 (last revise)
- * @version 1.2
+ * @date 2026/10/17 (last revise)
+ * @version 1.3
  */
 #ifndef _PLATFORM_H_
 #define _PLATFORM_H_
@@ -24,7 +24,18 @@ typedef uint8_t Byte;
 
 typedef uint8_t Idx8; ///< 8 bit index
 typedef uint16_t Idx16; ///< 16 bit index
-typedef Idx16 Index;
+#if defined(__C51__)
+    typedef Idx16 Index;
+#else
+    typedef size_t Index; ///< host: bitmaps and buffers beyond 64K
+#endif
+
+/// Storage class of the functions generated by TypedQueue.h
+#if defined(__C51__)
+    #define TQ_INLINE   static          // Keil C51 has no inline
+#else
+    #define TQ_INLINE   static inline
+#endif
 
 
 #endif // _PLATFORM_H_
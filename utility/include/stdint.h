@@ -18,10 +18,18 @@
 /**
  * @file stdint.h
  *      This file is modified for Keil C
+ * @note With GCC (not Keil C), the compiler's own <stdint.h> is used instead,
+ *      so the host gets exact 32-bit types and the 64-bit types.
  * @author Jiang Yu-Kuan, yukuan.jiang@gmail.com
  * @date 2005/3/14 (initial)
+ * @date 2026/10/17 (last revise)
  */
-//#ifdef __C51__
+#if defined(__GNUC__) && !defined(__C51__)
+
+#pragma GCC system_header
+#include_next <stdint.h>
+
+#else
 
 #ifndef _STDINT_H
 #define _STDINT_H
@@ -164,4 +172,4 @@ typedef unsigned long   uintmax_t;
 
 #endif // _STDINT_H
 
-//#endif // __C51__
+#endif // __GNUC__ && !__C51__